@@ -18,6 +18,8 @@ GROUP NUMBER : 45
     Post-condition:
              - *GDS points to a newly created Graph whose adjacency lists
                reflect the file's contents.
+             - Labels may be of any length; each distinct label is stored once
+               in the graph's LabelArena.
              - File pointer is closed before returning.
              - On failure, *GDS is left unmodified.
 */
@@ -40,54 +42,811 @@ int ReadInputFile(strFile strInputFileName, Graph** GDS) {
         return 0;
     }
 
-    strName token;
-    strName flag = "-1";      // sentinel marking end of one vertex's neighbors
-    int i, exitFlag;
+    size_t tokenCap = 64;
+    char* token = malloc(tokenCap);
+    const char* flag = "-1";  // sentinel marking end of one vertex's neighbors
+    int i, len, exitFlag;
+    if (token == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
     
     // 4) For each vertex, read its line of adjacency info
     for (i = 0; i < numVertex; i++) {
         exitFlag = 0;
 
         // 4a) First token is the vertex's own label
-        fscanf(fp, "%s", token);
-        appendNode(&newGraph->adjList[i], token);
+        len = readToken(fp, &token, &tokenCap);
+        appendNode(&newGraph->adjList[i], internLabel(newGraph->labels, token, len > 0 ? len : 0));
 
-        // 4b) Subsequent tokens are neighbors until we hit "-1"
+        // 4b) Subsequent tokens are neighbors until we hit "-1" (or the file ends)
         while (!exitFlag) {
-            fscanf(fp, "%s", token);
-            if (strcmp(token, flag) != 0) {
-                appendNode(&newGraph->adjList[i], token);
+            len = readToken(fp, &token, &tokenCap);
+            if (len >= 0 && strcmp(token, flag) != 0) {
+                appendNode(&newGraph->adjList[i], internLabel(newGraph->labels, token, len));
             } else {
                 exitFlag = 1; // done with this vertex's neighbor list
             }
         }
     }
+    free(token);
+
+    // 5) Rank the labels and map them to vertices for O(1) name lookups
+    buildLabelIndex(newGraph);
 
-    // 5) Hand the new graph back to the caller
+    // 6) Hand the new graph back to the caller
     *GDS = newGraph;
     fclose(fp);
     return 1;
 }
 
+/**
+    Purpose: Finds where the next vertex record starts at or after a byte offset.
+    Returns: Offset just past the first whole "-1" token at or after pos; len if none
+    @param  : buf - file contents
+    @param  : len - number of bytes in buf
+    @param  : pos - offset to start searching from
+    Pre-condition:
+             - buf must hold len bytes.
+    Post-condition:
+             - Only a "-1" delimited by whitespace (or buffer ends) counts, so
+               labels that merely contain "-1" are never split.
+*/
+size_t nextRecordStart(const char* buf, size_t len, size_t pos) {
+    while (pos + 1 < len) {
+        if (buf[pos] == '-' && buf[pos + 1] == '1' &&
+            (pos == 0 || isspace((unsigned char) buf[pos - 1])) &&
+            (pos + 2 == len || isspace((unsigned char) buf[pos + 2]))) {
+            return pos + 2;
+        }
+        pos++;
+    }
+    return len;
+}
+
+/**
+    Purpose: Parses one chunk of vertex records into a thread-private buffer.
+    Returns: void
+    @param  : buf   - file contents
+    @param  : chunk - chunk to parse; begin/end must already be set
+    Pre-condition:
+             - chunk->begin lies on a record boundary.
+    Post-condition:
+             - chunk->labelStart/labelLen hold every label of the chunk as a span
+               of buf, in file order, and chunk->lineLen[v] is the number of
+               labels (vertex + neighbors) of the chunk's v-th record.
+             - Nothing is copied, so labels of any length are kept whole.
+             - Program exits on malloc failure.
+*/
+void parseChunk(const char* buf, ParseChunk* chunk) {
+    size_t pos = chunk->begin;
+    int labelCap = 64, lineCap = 16;
+    int expectingHead = 1;
+
+    chunk->numRecords = 0;
+    chunk->numLabels = 0;
+    chunk->labelStart = malloc(labelCap * sizeof(size_t));
+    chunk->labelLen = malloc(labelCap * sizeof(int));
+    chunk->labelId = NULL;
+    chunk->lineLen = malloc(lineCap * sizeof(int));
+    if (chunk->labelStart == NULL || chunk->labelLen == NULL || chunk->lineLen == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    while (pos < chunk->end) {
+        // skip whitespace, then take one token
+        while (pos < chunk->end && isspace((unsigned char) buf[pos])) {
+            pos++;
+        }
+        size_t start = pos;
+        while (pos < chunk->end && !isspace((unsigned char) buf[pos])) {
+            pos++;
+        }
+        size_t tokenLen = pos - start;
+
+        if (tokenLen == 0) {
+            // trailing whitespace
+        } else if (!expectingHead && tokenLen == 2 && buf[start] == '-' && buf[start + 1] == '1') {
+            expectingHead = 1;   // done with this vertex's neighbor list
+        } else {
+            if (chunk->numLabels == labelCap) {
+                labelCap *= 2;
+                chunk->labelStart = realloc(chunk->labelStart, labelCap * sizeof(size_t));
+                chunk->labelLen = realloc(chunk->labelLen, labelCap * sizeof(int));
+            }
+            if (expectingHead && chunk->numRecords == lineCap) {
+                lineCap *= 2;
+                chunk->lineLen = realloc(chunk->lineLen, lineCap * sizeof(int));
+            }
+            if (chunk->labelStart == NULL || chunk->labelLen == NULL || chunk->lineLen == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+
+            chunk->labelStart[chunk->numLabels] = start;
+            chunk->labelLen[chunk->numLabels] = (int) tokenLen;
+            chunk->numLabels++;
+
+            if (expectingHead) {
+                // first token of a record is the vertex's own label
+                chunk->lineLen[chunk->numRecords] = 1;
+                chunk->numRecords++;
+                expectingHead = 0;
+            } else {
+                chunk->lineLen[chunk->numRecords - 1]++;
+            }
+        }
+    }
+}
+
+/**
+    Purpose: Reads a graph file by parsing line-aligned chunks on several threads.
+    Returns: 1 if successful; 0 if the file cannot be opened; -1 if it is malformed
+             (no vertex count in the header, or fewer records than declared).
+    @param  : strInputFileName - name of the input file containing graph data
+    @param  : GDS              - address of a Graph* to populate
+    @param  : numThreads       - number of chunks/threads; <= 0 uses every available core
+    Pre-condition:
+             - strInputFileName must be a valid, null-terminated string.
+             - GDS must be non-NULL.
+    Post-condition:
+             - *GDS holds the same graph ReadInputFile would build, vertices in file order.
+             - The file is split after "-1" sentinels, each chunk is parsed into its own
+               label buffer, and a serial prefix sum over the chunks' record counts (one
+               entry per thread) gives each chunk its first vertex index so the adjacency
+               lists are filled in parallel.
+             - Vertex labels are interned first, in file order; neighbor labels are then
+               looked up in parallel and only the misses (labels that are not a
+               vertex) are interned one by one.
+             - Parallelism uses OpenMP when compiled with it (e.g. -fopenmp); otherwise
+               the chunks are parsed one after another with identical results.
+             - On failure, *GDS is left unmodified.
+*/
+int ReadInputFileParallel(strFile strInputFileName, Graph** GDS, int numThreads) {
+    // 1) Slurp the file
+    FILE* fp = fopen(strInputFileName, "rb");
+    if (fp == NULL) {
+        return 0;
+    }
+    size_t cap = 1 << 16, len = 0, got;
+    char* buf = malloc(cap);
+    if (buf == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    while ((got = fread(buf + len, 1, cap - len, fp)) > 0) {
+        len += got;
+        if (len == cap) {
+            cap *= 2;
+            buf = realloc(buf, cap);
+            if (buf == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+        }
+    }
+    fclose(fp);
+
+    // 2) Read number of vertices from the header
+    size_t body = 0;
+    while (body < len && isspace((unsigned char) buf[body])) {
+        body++;
+    }
+    int numVertex = 0, digits = 0;
+    while (body < len && buf[body] >= '0' && buf[body] <= '9' && numVertex <= (INT_MAX - 9) / 10) {
+        numVertex = numVertex * 10 + (buf[body] - '0');
+        digits++;
+        body++;
+    }
+    if (digits == 0 || (body < len && !isspace((unsigned char) buf[body]))) {
+        fprintf(stderr, "Error: %s does not start with a vertex count.\n", strInputFileName);
+        free(buf);
+        return -1;
+    }
+
+    // 3) Split the body into chunks that start on record boundaries
+    if (numThreads <= 0) {
+#ifdef _OPENMP
+        numThreads = omp_get_max_threads();
+#else
+        numThreads = 1;
+#endif
+    }
+    ParseChunk* chunks = calloc(numThreads, sizeof(ParseChunk));
+    int* firstVertex = malloc((numThreads + 1) * sizeof(int));
+    if (chunks == NULL || firstVertex == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int t;
+    size_t prev = body;
+    for (t = 0; t < numThreads; t++) {
+        chunks[t].begin = prev;
+        if (t == numThreads - 1) {
+            chunks[t].end = len;
+        } else {
+            size_t guess = body + (len - body) / numThreads * (t + 1);
+            chunks[t].end = nextRecordStart(buf, len, guess > prev ? guess : prev);
+        }
+        prev = chunks[t].end;
+    }
+
+    // 4) Parse every chunk into its own buffer
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(numThreads) schedule(static, 1)
+#endif
+    for (t = 0; t < numThreads; t++) {
+        parseChunk(buf, &chunks[t]);
+    }
+
+    // 5) Prefix sum of record counts -> first vertex index of each chunk
+    firstVertex[0] = 0;
+    for (t = 0; t < numThreads; t++) {
+        firstVertex[t + 1] = firstVertex[t] + chunks[t].numRecords;
+    }
+
+    // extra records are ignored, as ReadInputFile ignores them
+    Graph* newGraph = NULL;
+    if (firstVertex[numThreads] >= numVertex) {
+        newGraph = createGraph(numVertex);
+    } else {
+        fprintf(stderr, "Error: %s declares %d vertices but holds %d vertex lines.\n",
+                strInputFileName, numVertex, firstVertex[numThreads]);
+    }
+
+    if (newGraph != NULL) {
+        LabelArena* labels = newGraph->labels;
+        for (t = 0; t < numThreads; t++) {
+            chunks[t].labelId = malloc((chunks[t].numLabels > 0 ? chunks[t].numLabels : 1) * sizeof(int));
+            if (chunks[t].labelId == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+        }
+
+        // 6) Intern vertex labels in file order
+        for (t = 0; t < numThreads; t++) {
+            int label = 0;
+            for (int r = 0; r < chunks[t].numRecords; r++) {
+                chunks[t].labelId[label] = internLabel(labels, buf + chunks[t].labelStart[label],
+                                                       chunks[t].labelLen[label]);
+                label += chunks[t].lineLen[r];
+            }
+        }
+
+        // 7) Resolve neighbor labels; the arena is read-only here
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(numThreads) schedule(static, 1)
+#endif
+        for (t = 0; t < numThreads; t++) {
+            int label = 0;
+            for (int r = 0; r < chunks[t].numRecords; r++) {
+                for (int k = 1; k < chunks[t].lineLen[r]; k++) {
+                    chunks[t].labelId[label + k] = findLabel(labels, buf + chunks[t].labelStart[label + k],
+                                                             chunks[t].labelLen[label + k]);
+                }
+                label += chunks[t].lineLen[r];
+            }
+        }
+        for (t = 0; t < numThreads; t++) {
+            for (int k = 0; k < chunks[t].numLabels; k++) {
+                if (chunks[t].labelId[k] < 0) {
+                    chunks[t].labelId[k] = internLabel(labels, buf + chunks[t].labelStart[k],
+                                                       chunks[t].labelLen[k]);
+                }
+            }
+        }
+
+        // 8) Fill the adjacency lists; chunks own disjoint vertex ranges
+#ifdef _OPENMP
+        #pragma omp parallel for num_threads(numThreads) schedule(static, 1)
+#endif
+        for (t = 0; t < numThreads; t++) {
+            int label = 0;
+            for (int r = 0; r < chunks[t].numRecords; r++) {
+                int v = firstVertex[t] + r;
+                for (int k = 0; k < chunks[t].lineLen[r] && v < numVertex; k++) {
+                    appendNode(&newGraph->adjList[v], chunks[t].labelId[label + k]);
+                }
+                label += chunks[t].lineLen[r];
+            }
+        }
+        buildLabelIndex(newGraph);
+        *GDS = newGraph;
+    }
+    free(buf);
+
+    for (t = 0; t < numThreads; t++) {
+        free(chunks[t].labelStart);
+        free(chunks[t].labelLen);
+        free(chunks[t].labelId);
+        free(chunks[t].lineLen);
+    }
+    free(chunks);
+    free(firstVertex);
+    return newGraph != NULL ? 1 : -1;
+}
+
+
+/**
+    Purpose: Sorts packed (source, destination) edge keys with an LSD radix sort.
+    Returns: void
+    @param  : keys - edges packed as (source << 32) | destination
+    @param  : tmp  - scratch array of at least count keys
+    @param  : count - number of keys
+    Post-condition:
+             - keys is sorted ascending. All eight byte histograms are built in
+               one pass, and a byte every key shares is skipped, so small graphs
+               (ids below 2^16) take only four scatter passes.
+*/
+void radixSortEdges(uint64_t keys[], uint64_t tmp[], size_t count) {
+    size_t hist[8][256];
+    size_t i;
+    int pass, b;
+    memset(hist, 0, sizeof(hist));
+    for (i = 0; i < count; i++) {
+        for (pass = 0; pass < 8; pass++) {
+            hist[pass][(keys[i] >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    uint64_t* src = keys;
+    uint64_t* dst = tmp;
+    for (pass = 0; pass < 8; pass++) {
+        if (count == 0 || hist[pass][(keys[0] >> (pass * 8)) & 0xFF] == count) {
+            continue;   // every key has the same byte here
+        }
+        size_t pos = 0;
+        for (b = 0; b < 256; b++) {
+            size_t n = hist[pass][b];
+            hist[pass][b] = pos;
+            pos += n;
+        }
+        for (i = 0; i < count; i++) {
+            dst[hist[pass][(src[i] >> (pass * 8)) & 0xFF]++] = src[i];
+        }
+        uint64_t* swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != keys) {
+        memcpy(keys, src, count * sizeof(uint64_t));
+    }
+}
+
+/**
+    Purpose: Reads a graph from an edge list ("u v" per edge) without going through the adjacency format.
+    Returns: 1 if successful; 0 if the file cannot be opened
+    @param  : strInputFileName - name of the edge-list file
+    @param  : GDS              - address of a Graph* to populate
+    @param  : symmetrize       - nonzero adds v -> u for every u -> v read
+    Pre-condition:
+             - One edge per line, labels separated by blanks; a token starting with
+               '#' comments out the rest of its line.
+    Post-condition:
+             - Pairing restarts on every line, so a line with an odd number of
+               labels cannot shift the lines after it: its last label is reported
+               on stderr and ignored (it does not become a vertex).
+             - Vertices are numbered in order of first appearance and edges are
+               streamed into packed 64-bit keys, radix sorted and deduplicated,
+               so each row lists its neighbors once, in vertex order.
+             - Self-loops are kept, like ReadInputFile does.
+             - Program exits on malloc failure.
+*/
+int ReadEdgeListFile(strFile strInputFileName, Graph** GDS, int symmetrize) {
+    // 1) Open the file
+    FILE* fp = fopen(strInputFileName, "r");
+    if (fp == NULL) {
+        return 0;
+    }
+
+    // 2) Stream the edges; label ids double as vertex indices
+    LabelArena* labels = createLabelArena(1024);
+    size_t tokenCap = 64, firstCap = 64, edgeCap = 1024, numEdges = 0;
+    char* token = malloc(tokenCap);
+    char* first = malloc(firstCap);    // first label of the line, until its partner is read
+    uint64_t* edges = malloc(edgeCap * sizeof(uint64_t));
+    if (token == NULL || first == NULL || edges == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int c, len, firstLen = -1, line = 1;
+    do {
+        c = fgetc(fp);
+        if (c == '\n' || c == EOF) {
+            if (firstLen >= 0) {
+                fprintf(stderr, "Warning: %s line %d: label %s has no partner; ignored.\n",
+                        strInputFileName, line, first);
+                firstLen = -1;
+            }
+            line++;
+        } else if (!isspace(c)) {
+            ungetc(c, fp);
+            len = readToken(fp, &token, &tokenCap);
+            if (token[0] == '#') {
+                int skip;
+                while ((skip = fgetc(fp)) != EOF && skip != '\n') {
+                    // skip the comment
+                }
+                if (skip == '\n') {
+                    ungetc(skip, fp);   // leave the line end to the check above
+                }
+            } else if (firstLen < 0) {
+                char* swap = first;    // keep the label; token's buffer is reused
+                size_t swapCap = firstCap;
+                first = token;
+                firstCap = tokenCap;
+                token = swap;
+                tokenCap = swapCap;
+                firstLen = len;
+            } else {
+                int from = internLabel(labels, first, firstLen);
+                int to = internLabel(labels, token, len);
+                firstLen = -1;
+                if (numEdges + 2 > edgeCap) {
+                    edgeCap *= 2;
+                    edges = realloc(edges, edgeCap * sizeof(uint64_t));
+                    if (edges == NULL) {
+                        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                        exit(1);
+                    }
+                }
+                edges[numEdges] = ((uint64_t) from << 32) | (uint32_t) to;
+                numEdges++;
+                if (symmetrize && to != from) {
+                    edges[numEdges] = ((uint64_t) to << 32) | (uint32_t) from;
+                    numEdges++;
+                }
+            }
+        }
+    } while (c != EOF);
+    free(token);
+    free(first);
+    fclose(fp);
+
+    // 3) Sort, then drop repeated edges
+    uint64_t* tmp = malloc((numEdges > 0 ? numEdges : 1) * sizeof(uint64_t));
+    if (tmp == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    radixSortEdges(edges, tmp, numEdges);
+    free(tmp);
+    size_t e, unique = 0;
+    for (e = 0; e < numEdges; e++) {
+        if (unique == 0 || edges[e] != edges[unique - 1]) {
+            edges[unique] = edges[e];
+            unique++;
+        }
+    }
+
+    // 4) Build the lists: a head per vertex, then its sorted row
+    Graph* newGraph = createGraph(labels->count);
+    if (newGraph == NULL) {
+        freeLabelArena(labels);
+        free(edges);
+        return 0;
+    }
+    freeLabelArena(newGraph->labels);
+    newGraph->labels = labels;
+    int v;
+    for (v = 0; v < newGraph->numVertices; v++) {
+        appendNode(&newGraph->adjList[v], v);
+    }
+    for (e = 0; e < unique; e++) {
+        appendNode(&newGraph->adjList[edges[e] >> 32], (int) (edges[e] & 0xFFFFFFFFu));
+    }
+    free(edges);
+
+    // 5) Rank the labels and map them to vertices
+    buildLabelIndex(newGraph);
+    *GDS = newGraph;
+    return 1;
+}
+
+/**
+    Purpose: Reads one whitespace-delimited token of any length.
+    Returns: Length of the token; -1 at end of file
+    @param  : fp    - input stream
+    @param  : token - address of a malloc'd buffer (grown with realloc as needed)
+    @param  : cap   - address of the buffer's capacity
+    Post-condition:
+             - *token is null-terminated (empty at end of file).
+             - The whitespace character that ended the token is pushed back, so
+               callers can still tell whether the token ended its line.
+             - Program exits on malloc failure.
+*/
+int readToken(FILE* fp, char** token, size_t* cap) {
+    int c = fgetc(fp);
+    size_t len = 0;
+    while (c != EOF && isspace(c)) {
+        c = fgetc(fp);
+    }
+    while (c != EOF && !isspace(c)) {
+        if (len + 1 >= *cap) {
+            *cap *= 2;
+            *token = realloc(*token, *cap);
+            if (*token == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+        }
+        (*token)[len] = (char) c;
+        len++;
+        c = fgetc(fp);
+    }
+    if (c != EOF) {
+        ungetc(c, fp);
+    }
+    (*token)[len] = '\0';
+    return (len == 0 && c == EOF) ? -1 : (int) len;
+}
+
+/**
+    Purpose: Hashes a label (32-bit FNV-1a).
+    Returns: The hash
+    @param  : text - label characters (need not be null-terminated)
+    @param  : len  - number of characters
+*/
+uint32_t hashLabel(const char* text, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char) text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+    Purpose: Allocates an empty label arena.
+    Returns: Pointer to the new LabelArena
+    @param  : expected - number of labels to size the tables for (a hint)
+    Post-condition:
+             - Program exits on malloc failure.
+*/
+LabelArena* createLabelArena(int expected) {
+    LabelArena* a = malloc(sizeof(LabelArena));
+    if (a == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    a->refCap = expected > 16 ? expected : 16;
+    a->cap = (size_t) a->refCap * 8;
+    a->tableSize = 32;
+    while (a->tableSize < 2 * a->refCap) {
+        a->tableSize *= 2;
+    }
+    a->chars = malloc(a->cap);
+    a->refs = malloc(a->refCap * sizeof(LabelRef));
+    a->table = malloc(a->tableSize * sizeof(int));
+    if (a->chars == NULL || a->refs == NULL || a->table == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (int i = 0; i < a->tableSize; i++) {
+        a->table[i] = -1;
+    }
+    a->used = 0;
+    a->count = 0;
+    a->rank = NULL;
+    return a;
+}
+
+/**
+    Purpose: Frees a label arena.
+    Returns: NULL
+    @param  : a - pointer to the LabelArena
+    Post-condition:
+             - Returns NULL so caller can safely do: a = freeLabelArena(a);
+*/
+LabelArena* freeLabelArena(LabelArena* a) {
+    if (a != NULL) {
+        free(a->chars);
+        free(a->refs);
+        free(a->table);
+        free(a->rank);
+        free(a);
+    }
+    return NULL;
+}
+
+/**
+    Purpose: Makes a deep copy of a label arena.
+    Returns: Pointer to the new LabelArena, with the same label ids and ranks
+    @param  : a - arena to copy
+*/
+LabelArena* cloneLabelArena(const LabelArena* a) {
+    LabelArena* copy = malloc(sizeof(LabelArena));
+    if (copy == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    *copy = *a;
+    copy->chars = malloc(a->cap);
+    copy->refs = malloc(a->refCap * sizeof(LabelRef));
+    copy->table = malloc(a->tableSize * sizeof(int));
+    copy->rank = (a->rank != NULL) ? malloc((a->count > 0 ? a->count : 1) * sizeof(LabelKey)) : NULL;
+    if (copy->chars == NULL || copy->refs == NULL || copy->table == NULL ||
+        (a->rank != NULL && copy->rank == NULL)) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    memcpy(copy->chars, a->chars, a->used);
+    memcpy(copy->refs, a->refs, a->count * sizeof(LabelRef));
+    memcpy(copy->table, a->table, a->tableSize * sizeof(int));
+    if (a->rank != NULL) {
+        memcpy(copy->rank, a->rank, a->count * sizeof(LabelKey));
+    }
+    return copy;
+}
+
+/**
+    Purpose: Looks up a label in the arena.
+    Returns: The label's id; -1 if it was never interned
+    @param  : a    - pointer to the LabelArena
+    @param  : text - label characters (need not be null-terminated)
+    @param  : len  - number of characters
+    Post-condition:
+             - Read-only, so any number of threads may look up concurrently
+               while nobody interns.
+*/
+int findLabel(const LabelArena* a, const char* text, size_t len) {
+    uint32_t h = hashLabel(text, len);
+    int slot = (int) (h & (uint32_t) (a->tableSize - 1));
+    while (a->table[slot] >= 0) {
+        const LabelRef* r = &a->refs[a->table[slot]];
+        if (r->hash == h && r->length == len && memcmp(a->chars + r->offset, text, len) == 0) {
+            return a->table[slot];
+        }
+        slot = (slot + 1) & (a->tableSize - 1);
+    }
+    return -1;
+}
+
+/**
+    Purpose: Returns the id of a label, adding its text to the arena if it is new.
+    Returns: The label's id (0, 1, 2, ... in order of first appearance)
+    @param  : a    - pointer to the LabelArena
+    @param  : text - label characters (need not be null-terminated)
+    @param  : len  - number of characters
+    Post-condition:
+             - A new label invalidates a->rank until rankLabels runs again.
+             - Program exits on malloc failure.
+*/
+int internLabel(LabelArena* a, const char* text, size_t len) {
+    int id = findLabel(a, text, len);
+    if (id >= 0) {
+        return id;
+    }
+
+    // grow the hash table first so it stays at most half full
+    if (2 * (a->count + 1) > a->tableSize) {
+        free(a->table);
+        a->tableSize *= 2;
+        a->table = malloc(a->tableSize * sizeof(int));
+        if (a->table == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        int i;
+        for (i = 0; i < a->tableSize; i++) {
+            a->table[i] = -1;
+        }
+        for (i = 0; i < a->count; i++) {
+            int slot = (int) (a->refs[i].hash & (uint32_t) (a->tableSize - 1));
+            while (a->table[slot] >= 0) {
+                slot = (slot + 1) & (a->tableSize - 1);
+            }
+            a->table[slot] = i;
+        }
+    }
+    if (a->count == a->refCap) {
+        a->refCap *= 2;
+        a->refs = realloc(a->refs, a->refCap * sizeof(LabelRef));
+    }
+    while (a->used + len + 1 > a->cap) {
+        a->cap *= 2;
+        a->chars = realloc(a->chars, a->cap);
+    }
+    if (a->refs == NULL || a->chars == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    id = a->count;
+    a->refs[id].offset = a->used;
+    a->refs[id].length = (uint32_t) len;
+    a->refs[id].hash = hashLabel(text, len);
+    memcpy(a->chars + a->used, text, len);
+    a->chars[a->used + len] = '\0';
+    a->used += len + 1;
+    a->count++;
+
+    int slot = (int) (a->refs[id].hash & (uint32_t) (a->tableSize - 1));
+    while (a->table[slot] >= 0) {
+        slot = (slot + 1) & (a->tableSize - 1);
+    }
+    a->table[slot] = id;
+
+    free(a->rank);     // stale now
+    a->rank = NULL;
+    return id;
+}
+
+/**
+    Purpose: Returns the text of a label.
+    Returns: Null-terminated label, valid until the next internLabel on the arena
+    @param  : a  - pointer to the LabelArena
+    @param  : id - label id
+*/
+const char* labelText(const LabelArena* a, int id) {
+    return a->chars + a->refs[id].offset;
+}
+
+/**
+    Purpose: qsort comparator ordering labels like strcmp.
+    Returns: <0, 0 or >0
+    @param  : a - pointer to the first LabelSort
+    @param  : b - pointer to the second LabelSort
+*/
+int compareLabelSort(const void* a, const void* b) {
+    const LabelSort* x = a;
+    const LabelSort* y = b;
+    if (x->prefix != y->prefix) {
+        return (x->prefix > y->prefix) - (x->prefix < y->prefix);
+    }
+    return strcmp(x->text, y->text);
+}
+
+/**
+    Purpose: Computes every label's sort key (its rank in strcmp order).
+    Returns: void
+    @param  : a - pointer to the LabelArena
+    Post-condition:
+             - a->rank[id] orders ids exactly like strcmp orders their texts, so
+               the key-based sorts and searches elsewhere work for labels of
+               any length. Equal keys mean equal labels.
+             - Program exits on malloc failure.
+*/
+void rankLabels(LabelArena* a) {
+    int n = a->count;
+    LabelSort* sorted = malloc((n > 0 ? n : 1) * sizeof(LabelSort));
+    free(a->rank);
+    a->rank = malloc((n > 0 ? n : 1) * sizeof(LabelKey));
+    if (sorted == NULL || a->rank == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int i;
+    for (i = 0; i < n; i++) {
+        sorted[i].text = labelText(a, i);
+        sorted[i].prefix = makeLabelKey(sorted[i].text);
+        sorted[i].id = i;
+    }
+    qsort(sorted, n, sizeof(LabelSort), compareLabelSort);
+    for (i = 0; i < n; i++) {
+        a->rank[sorted[i].id] = (LabelKey) i;
+    }
+    free(sorted);
+}
 
 /*
     Purpose: Allocates and initializes a new adjacency-list node.
     Returns: Pointer to the new Node.
-    @param  : name — vertex name to store in the node
-    Pre-condition:
-             - name must be ≤ MAX_LABEL_LEN‑1 chars, null‑terminated.
+    @param  : label — id of the node's label in the graph's LabelArena
     Post-condition:
-             - A Node is malloc'd, vertexName set, edge = NULL.
+             - A Node is malloc'd, label set, edge = NULL.
              - Program exits on malloc failure.
 */
-Node* createNode(strName name) {
+Node* createNode(int label) {
     Node* n = malloc(sizeof(Node));
     if (n == NULL) {
         fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
         exit(1);
     }
-    // copy the 8‑char label into the new node
-    strcpy(n->vertexName, name);
+    // the text stays in the arena; the node only refers to it
+    n->label = label;
     n->edge = NULL;
     return n;
 }
@@ -110,15 +869,15 @@ void initList(List* l) {
     Purpose: Appends a new node with given name to the end of the list.
     Returns: void
     @param  : l    — pointer to the List to modify
-    @param  : name — vertex name to append
+    @param  : label — label id to append
     Pre-condition:
              - l must not be NULL.
     Post-condition:
              - A new Node is created and added at the tail of *l.
              - tail updated to point to the new node.
 */
-void appendNode(List* l, strName name) {
-    Node* n = createNode(name);
+void appendNode(List* l, int label) {
+    Node* n = createNode(label);
     if (l->head == NULL) {
         // first node in this adjacency list
         l->head = l->tail = n;
@@ -157,6 +916,7 @@ void freeList(List* l) {
     Post-condition:
              - Graph* is malloc'd.
              - adjList array is calloc'd and each List initialized.
+             - labels is an empty LabelArena; inputOrder and labelVertex are NULL.
              - On failure, allocated memory is freed and NULL is returned.
 */
 Graph* createGraph(int numVertices) {
@@ -167,6 +927,9 @@ Graph* createGraph(int numVertices) {
     }
 
     g->numVertices = numVertices;
+    g->inputOrder = NULL;   // identity until the graph is reordered
+    g->labels = createLabelArena(numVertices);
+    g->labelVertex = NULL;  // built by buildLabelIndex once labels are known
 
     if(numVertices == 0) {
         g->adjList = NULL;
@@ -177,6 +940,7 @@ Graph* createGraph(int numVertices) {
     g->adjList = calloc(numVertices, sizeof(List));
     if (g->adjList == NULL) {
         fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        freeLabelArena(g->labels);
         free(g);
         return NULL;
     }
@@ -199,15 +963,21 @@ Graph* createGraph(int numVertices) {
              - Vertex named 'from' must already be at head of one List.
     Post-condition:
              - If 'from' is found, a new node with 'to' is appended to its list.
+             - If 'to' is a label the graph has not seen, it is interned and the
+               label index is rebuilt so ranks and lookups stay valid.
              - On failure, prints an error and exits.
 */
-void addEdge(Graph* g, strName from, strName to) {
+void addEdge(Graph* g, const char* from, const char* to) {
     int i = 0, found = 0;
+    int fromLabel = findLabel(g->labels, from, strlen(from));
     // scan through each list's head for the 'from' label
-    while (i < g->numVertices && !found) {
-        if (g->adjList[i].head &&
-            strcmp(g->adjList[i].head->vertexName, from) == 0) {
-            appendNode(&g->adjList[i], to);
+    while (i < g->numVertices && !found && fromLabel >= 0) {
+        if (g->adjList[i].head && g->adjList[i].head->label == fromLabel) {
+            int known = g->labels->count;
+            appendNode(&g->adjList[i], internLabel(g->labels, to, strlen(to)));
+            if (g->labels->count != known) {
+                buildLabelIndex(g);
+            }
             found = 1;
         } else {
             i++;
@@ -228,7 +998,7 @@ void addEdge(Graph* g, strName from, strName to) {
              - g must not be NULL.
     Post-condition:
              - All adjacency-list nodes are freed.
-             - adjList array and Graph struct are freed.
+             - adjList array, inputOrder map, label arena and index and Graph struct are freed.
              - Returns NULL so caller can safely do: g = freeGraph(g);
 */
 Graph* freeGraph(Graph* g) {
@@ -238,6 +1008,9 @@ Graph* freeGraph(Graph* g) {
     }
     // free the array of lists, then the graph itself
     free(g->adjList);
+    free(g->inputOrder);
+    freeLabelArena(g->labels);
+    free(g->labelVertex);
     free(g);
     return NULL;
 }
@@ -252,11 +1025,21 @@ Graph* freeGraph(Graph* g) {
              - name must be a valid, null‑terminated string.
     Post-condition:
              - No modifications to g.
+             - One hash lookup in the label arena, then g->labelVertex when it is
+               built; otherwise a linear scan comparing label ids.
 */
-int getVertexIndex(const Graph* g, const strName name) {
+int getVertexIndex(const Graph* g, const char* name) {
+    int label = findLabel(g->labels, name, strlen(name));
+    if (label < 0) {
+        return -1;  // no vertex or neighbor has this label
+    }
+
+    if (g->labelVertex != NULL) {
+        return g->labelVertex[label];
+    }
+
     for (int i = 0; i < g->numVertices; i++) {
-        if (g->adjList[i].head != NULL &&
-            strcmp(g->adjList[i].head->vertexName, name) == 0) {
+        if (g->adjList[i].head != NULL && g->adjList[i].head->label == label) {
             return i;
         }
     }
@@ -264,9 +1047,46 @@ int getVertexIndex(const Graph* g, const strName name) {
 }
 
 /**
-    Purpose: Gathers neighbor indices of a vertex, sorts them alphabetically by name, and returns the count.
-    Returns: Number of neighbors found.
-    @param  : g     - pointer to the Graph.
+    Purpose: Returns a vertex's label.
+    Returns: Null-terminated label text, owned by the graph's arena
+    @param  : g - pointer to the Graph
+    @param  : v - vertex index
+*/
+const char* vertexLabel(const Graph* g, int v) {
+    return labelText(g->labels, g->adjList[v].head->label);
+}
+
+/**
+    Purpose: Returns a vertex's label sort key.
+    Returns: Key ordering vertices like strcmp on their labels
+    @param  : g - pointer to the Graph
+    @param  : v - vertex index
+    Pre-condition:
+             - The label index is built (see buildLabelIndex).
+*/
+LabelKey vertexKey(const Graph* g, int v) {
+    return g->labels->rank[g->adjList[v].head->label];
+}
+
+/**
+    Purpose: Resolves an adjacency-list node to the vertex it names.
+    Returns: Vertex index; -1 if the label is not a vertex
+    @param  : g - pointer to the Graph
+    @param  : n - node of one of g's lists
+    Post-condition:
+             - O(1) through g->labelVertex; falls back to getVertexIndex.
+*/
+int nodeVertex(const Graph* g, const Node* n) {
+    if (g->labelVertex != NULL) {
+        return g->labelVertex[n->label];
+    }
+    return getVertexIndex(g, labelText(g->labels, n->label));
+}
+
+/**
+    Purpose: Gathers neighbor indices of a vertex, sorts them alphabetically by name, and returns the count.
+    Returns: Number of neighbors found.
+    @param  : g     - pointer to the Graph.
     @param  : vIndex  - index of the vertex whose neighbors to collect.
     @param  : out   - pre-allocated array to fill with sorted neighbor indices.
     Pre-condition:
@@ -274,27 +1094,27 @@ int getVertexIndex(const Graph* g, const strName name) {
              - 0 <= vIndex < g->numVertices.
              - out must point to an array of at least g->numVertices ints.
     Post-condition:
-             - outIndex[0..count-1] contains neighbor indices sorted ascending order by vertexName.
+             - outIndex[0..count-1] contains neighbor indices sorted ascending order by label.
 */
 int getSortedNeighbors(const Graph* g, int vIndex, int outIndex[]) {
     int count = 0;
     // Collect the neighbor indices
     Node* cur = g->adjList[vIndex].head->edge;
     while (cur != NULL) {
-        int idx = getVertexIndex(g, cur->vertexName);
+        int idx = nodeVertex(g, cur);
         if (idx >= 0) {
             outIndex[count] = idx;
             count++;
         }
         cur = cur->edge;
     }
-    // Selection sort on the indices by comparing vertexName
+    // Selection sort on the indices by comparing label keys
     for (int i = 0; i < count - 1; i++) {
         int min = i;
         for (int j = i + 1; j < count; j++) {
-            const char* nameJ = g->adjList[outIndex[j]].head->vertexName;
-            const char* nameMin = g->adjList[outIndex[min]].head->vertexName;
-            if (strcmp(nameJ, nameMin) < 0) {
+            LabelKey keyJ = vertexKey(g, outIndex[j]);
+            LabelKey keyMin = vertexKey(g, outIndex[min]);
+            if (keyJ < keyMin) {
                 min = j;
             }
         }
@@ -308,312 +1128,1283 @@ int getSortedNeighbors(const Graph* g, int vIndex, int outIndex[]) {
 }
 
 /**
-    Purpose: Recursive helper for DFS traversal, stores visitation in traversal[] and marks visited
-    Returns: void
-    @param  : g         - pointer to the Graph
-    @param  : vIndex      - current vertex index
-    @param  : visited   - int array marking visited vertices (1 = visited, 0 = not)
-    @param  : traversal - array of strName to record visitation order
-    @param  : travIndex - pointer to current index in traversal array
+    Purpose: Gathers a vertex's neighbors sorted by label into a buffer sized to the row.
+    Returns: Number of neighbors found
+    @param  : g      - pointer to the Graph
+    @param  : vIndex - index of the vertex whose neighbors to collect
+    @param  : buf    - address of a malloc'd KeyIndex buffer (grown with realloc as needed)
+    @param  : cap    - address of the buffer's capacity
     Pre-condition:
-        - g, visited, traversal, travIndex must not be NULL
-        - visited and traversal arrays size >= g->numVertices
+             - The label index is built (see buildLabelIndex).
     Post-condition:
-        - traversal[0..*travIndex-1] holds names in DFS order
+             - (*buf)[i].index is the i-th neighbor, in the same order as
+               getSortedNeighbors, but without a V-sized output array and with
+               qsort instead of a quadratic sort.
+             - Program exits on malloc failure.
 */
-void DFSHelper(const Graph* g, int vIndex, int visited[], strName traversal[], int* travIndex) {
-    // mark and record this vertex
-    visited[vIndex] = 1;
-    strcpy(traversal[*travIndex], g->adjList[vIndex].head->vertexName);
-    *travIndex += 1;
+int sortedNeighborRow(const Graph* g, int vIndex, KeyIndex** buf, int* cap) {
+    int count = 0;
+    for (Node* cur = g->adjList[vIndex].head->edge; cur != NULL; cur = cur->edge) {
+        int idx = nodeVertex(g, cur);
+        if (idx >= 0) {
+            if (count == *cap) {
+                *cap *= 2;
+                *buf = realloc(*buf, *cap * sizeof(KeyIndex));
+                if (*buf == NULL) {
+                    fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                    exit(1);
+                }
+            }
+            (*buf)[count].key = vertexKey(g, idx);
+            (*buf)[count].index = idx;
+            count++;
+        }
+    }
+    // equal keys mean the same vertex, so qsort's instability cannot reorder them
+    qsort(*buf, count, sizeof(KeyIndex), compareKeyIndex);
+    return count;
+}
 
-     // get sorted neighbor indices
-    int neighbors[g->numVertices];
-    int neighborCount = getSortedNeighbors(g, vIndex, neighbors);
+/**
+    Purpose: Maps a position in the input file to the vertex's current index.
+    Returns: Index into g->adjList of the vertex that was on line pos of the input
+    @param  : g   - pointer to the Graph
+    @param  : pos - 0-based vertex line number in the input file
+    Pre-condition:
+             - g must not be NULL.
+             - 0 <= pos < g->numVertices.
+    Post-condition:
+             - Returns pos itself when the graph has never been reordered.
+*/
+int vertexAtInputPos(const Graph* g, int pos) {
+    if (g->inputOrder == NULL) {
+        return pos;
+    }
+    return g->inputOrder[pos];
+}
 
-     // visit each neighbor in order
-    for (int i = 0; i < neighborCount; i++) {
-        int u = neighbors[i];
-        if (!visited[u]) {
-            DFSHelper(g, u, visited, traversal, travIndex);
+/**
+    Purpose: Packs the first 8 characters of a label into a big-endian 64-bit key.
+    Returns: The key; the first character occupies the most significant byte
+    @param  : name - null-terminated label
+    Pre-condition:
+             - name must not be NULL.
+    Post-condition:
+             - Unused low bytes are zero, so unsigned key order agrees with strcmp
+               order; labels sharing an 8-character prefix tie (see rankLabels).
+*/
+LabelKey makeLabelKey(const char* name) {
+    LabelKey key = 0;
+    for (int i = 0; i < 8; i++) {
+        key <<= 8;
+        if (*name != '\0') {
+            key |= (unsigned char) *name;
+            name++;
         }
     }
+    return key;
 }
 
 /**
-    Purpose: Performs a depth-first search starting from a given vertex name.
-    Returns: Number of vertices traversed
-    @param  : g         - pointer to the Graph
-    @param  : startName - name of the start vertex
-    @param  : traversal - array of strName to fill with DFS visit order
+    Purpose: qsort comparator ordering KeyIndex entries by label key, then by index.
+    Returns: <0, 0 or >0 like strcmp on the underlying labels; equal labels by ascending index
+    @param  : a - pointer to the first KeyIndex
+    @param  : b - pointer to the second KeyIndex
+    Post-condition:
+             - qsort is not stable, so the index tie-break is what keeps vertices
+               sharing a label in a fixed order.
+*/
+int compareKeyIndex(const void* a, const void* b) {
+    const KeyIndex* x = a;
+    const KeyIndex* y = b;
+    if (x->key != y->key) {
+        return (x->key > y->key) - (x->key < y->key);
+    }
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+/**
+    Purpose: Builds (or rebuilds) the label ranks and the label -> vertex map.
+    Returns: void
+    @param  : g - pointer to the Graph
     Pre-condition:
-        - g and traversal must not be NULL
-        - traversal array size >= g->numVertices
-        - startName must correspond to an existing vertex
+             - g must not be NULL and every adjList[i].head must be set.
     Post-condition:
-        - traversal[0..n-1] holds the DFS order; n = number of reachable vertices
+             - g->labels->rank is current, so vertexKey works.
+             - g->labelVertex maps every label id to its vertex (-1 for labels
+               that only appear as neighbors); with duplicate vertex labels the
+               first input line wins, so reordering never changes which vertex
+               a neighbor label names.
+             - Program exits on malloc failure.
 */
-int DFS(const Graph* g, const strName startName, strName traversal[]) {
-     // allocate and initialize to zero visited flags
-    int *visited = calloc(g->numVertices, sizeof(*visited));
-    if (visited == NULL) {
+void buildLabelIndex(Graph* g) {
+    int count = g->labels->count;
+    rankLabels(g->labels);
+    free(g->labelVertex);
+    g->labelVertex = malloc((count > 0 ? count : 1) * sizeof(int));
+    if (g->labelVertex == NULL) {
         fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
         exit(1);
     }
-    int travIndex = 0;
-
-    // find the start vertex
-    int start = getVertexIndex(g, startName);
-    if (start < 0) {
-        fprintf(stderr, "Vertex %s not found", startName);
-        free(visited);
-        exit(1);
+    int i;
+    for (i = 0; i < count; i++) {
+        g->labelVertex[i] = -1;
     }
+    for (i = g->numVertices - 1; i >= 0; i--) {
+        int v = vertexAtInputPos(g, i);
+        g->labelVertex[g->adjList[v].head->label] = v;
+    }
+}
 
-    // run recursive DFS
-    DFSHelper(g, start, visited, traversal, &travIndex);
-
-    // clean up
-    free(visited);
-    return travIndex;
+/**
+    Purpose: Finds a label key in a contiguous array of keys (e.g. one neighbor row).
+    Returns: Position of the first match; -1 if absent
+    @param  : keys  - array of label keys
+    @param  : count - number of keys in the array
+    @param  : key   - key to look for
+    Pre-condition:
+             - keys must hold at least count entries.
+    Post-condition:
+             - With SSE2, four keys are compared per iteration: 32-bit lane
+               compares are AND-ed with their swapped halves so a 64-bit lane
+               only matches when both halves do.
+*/
+int findLabelKey(const LabelKey keys[], int count, LabelKey key) {
+    int i = 0;
+#ifdef __SSE2__
+    __m128i needle = _mm_set1_epi64x((long long) key);
+    for (; i + 4 <= count; i += 4) {
+        __m128i lo = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (keys + i)), needle);
+        __m128i hi = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (keys + i + 2)), needle);
+        lo = _mm_and_si128(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+        hi = _mm_and_si128(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(lo)) |
+                   (_mm_movemask_pd(_mm_castsi128_pd(hi)) << 2);
+        if (mask != 0) {
+            int bit = 0;
+            while (!(mask & 1)) {
+                mask >>= 1;
+                bit++;
+            }
+            return i + bit;
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        if (keys[i] == key) {
+            return i;
+        }
+    }
+    return -1;
 }
 
 /**
-        Purpose: Performs a breadth-first search starting from a given vertex name and records order in traversal[].
-        Returns: Number of vertices traversed
-        @param  : g         - pointer to the Graph
-        @param  : startName - name of the start vertex
-        @param  : traversal - array of strName to fill with BFS visit order
-        Pre-condition:
-            - g and traversal must not be NULL
-            - traversal array size >= g->numVertices
-            - startName corresponds to an existing vertex
-        Post-condition:
-            - traversal[0..n-1] holds the BFS order; n = number of reachable vertices
+    Purpose: Builds a compressed (CSR) index form of the adjacency lists.
+    Returns: Pointer to the new GraphCSR
+    @param  : g - pointer to the Graph
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data.
+    Post-condition:
+             - neighbors[offsets[v] .. offsets[v+1]-1] hold v's neighbor indices,
+               in adjacency-list order. Labels that are not a vertex are dropped.
+             - Labels are resolved with nodeVertex, which is O(1) once the
+               label index is built.
+             - Program exits on malloc failure.
 */
-int BFS(const Graph* g, const strName startName, strName traversal[]) {
-     // allocate and zero visited flags
-    int *visited = calloc(g->numVertices, sizeof(*visited));
-    if (visited == NULL) {
+GraphCSR* buildCSR(const Graph* g) {
+    int n = g->numVertices;
+    int i, total = 0;
+
+    // count adjacency entries so the neighbor array is allocated once
+    for (i = 0; i < n; i++) {
+        Node* cur = g->adjList[i].head->edge;
+        while (cur != NULL) {
+            total++;
+            cur = cur->edge;
+        }
+    }
+
+    GraphCSR* csr = malloc(sizeof(GraphCSR));
+    if (csr == NULL) {
         fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
         exit(1);
     }
-    // allocate queue for vertex indices
-    int *queue = calloc(g->numVertices, sizeof(*queue));
-    if (queue == NULL) {
+    csr->numVertices = n;
+    csr->offsets = malloc((n + 1) * sizeof(int));
+    csr->neighbors = malloc((total > 0 ? total : 1) * sizeof(int));
+    if (csr->offsets == NULL || csr->neighbors == NULL) {
         fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
-        free(visited);
         exit(1);
     }
 
-    int front = 0, rear = 0;
-    int travIndex = 0;
-
-    // find start vertex index
-    int start = getVertexIndex(g, startName);
-    if (start < 0) {
-        fprintf(stderr, "Vertex %s not found", startName);
-        exit(1);
+    int k = 0;
+    for (i = 0; i < n; i++) {
+        csr->offsets[i] = k;
+        Node* cur = g->adjList[i].head->edge;
+        while (cur != NULL) {
+            int idx = nodeVertex(g, cur);
+            if (idx >= 0) {
+                csr->neighbors[k] = idx;
+                k++;
+            }
+            cur = cur->edge;
+        }
     }
-    // enqueue and record the start vertex
-    visited[start] = 1;
-    queue[rear] = start;
-    rear++;
+    csr->offsets[n] = k;
+    csr->numEdges = k;
 
-    // process queue
-    while (front < rear) {
-        int v = queue[front];
-        front++;
-        strcpy(traversal[travIndex], g->adjList[v].head->vertexName);
-        travIndex++;
-        // get sorted neighbor indices
-        int neighbors[g->numVertices];
-        int cnt = getSortedNeighbors(g, v, neighbors);
-        for (int i = 0; i < cnt; i++) {
-            int u = neighbors[i];
-            if (!visited[u]) {
-                visited[u] = 1;
-                queue[rear] = u;
-                rear++;
+    return csr;
+}
+
+/**
+    Purpose: qsort comparator for ascending ints.
+    Returns: <0, 0 or >0
+    @param  : a - pointer to the first int
+    @param  : b - pointer to the second int
+*/
+int compareInt(const void* a, const void* b) {
+    int x = *(const int*) a;
+    int y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
+/**
+    Purpose: Builds a CSR whose neighbor rows are sorted by index and duplicate-free.
+    Returns: Pointer to the new GraphCSR
+    @param  : g - pointer to the Graph
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data.
+    Post-condition:
+             - Each row is strictly increasing with self-loops removed, which is
+               what merge-based set operations (e.g. intersectCount) require.
+*/
+GraphCSR* buildSortedCSR(const Graph* g) {
+    GraphCSR* csr = buildCSR(g);
+    int k = 0;
+    for (int v = 0; v < csr->numVertices; v++) {
+        int begin = csr->offsets[v];
+        int end = csr->offsets[v + 1];
+        qsort(csr->neighbors + begin, end - begin, sizeof(int), compareInt);
+
+        // compact in place, dropping repeats and self-loops
+        csr->offsets[v] = k;
+        for (int e = begin; e < end; e++) {
+            int u = csr->neighbors[e];
+            if (u != v && (k == csr->offsets[v] || csr->neighbors[k - 1] != u)) {
+                csr->neighbors[k] = u;
+                k++;
             }
         }
     }
-    // clean up
-    free(visited);
-    free(queue);
-    return travIndex;
+    csr->offsets[csr->numVertices] = k;
+    csr->numEdges = k;
+    return csr;
 }
 
 /**
-    Purpose: Generates a file that contains the set of vertices and the set of edges. (<input>-SET.TXT).
+    Purpose: Frees a GraphCSR built by buildCSR.
+    Returns: NULL
+    @param  : csr - pointer to the GraphCSR to free
+    Post-condition:
+             - Returns NULL so caller can safely do: csr = freeCSR(csr);
+*/
+GraphCSR* freeCSR(GraphCSR* csr) {
+    if (csr != NULL) {
+        free(csr->offsets);
+        free(csr->neighbors);
+        free(csr);
+    }
+    return NULL;
+}
+
+/**
+    Purpose: Computes a locality-improving vertex order (old indices listed in new order).
     Returns: void
-    @param  : g             - pointer to the Graph
-    @param  : inputFilename - name of the input file (e.g., "G.TXT")
+    @param  : csr   - index form of the graph
+    @param  : mode  - REORDER_DEGREE or REORDER_RCM
+    @param  : order - output array; order[k] = old index of the vertex placed at k
     Pre-condition:
-             - g must not be NULL and must contain valid graph data
-			 - g is an UNDIRECTED graph.
-             - inputFilename must be a valid null-terminated string
+             - csr must not be NULL; order must hold csr->numVertices ints.
+    Post-condition:
+             - REORDER_DEGREE: vertices by descending degree (ties keep input order),
+               so hub lists sit together at the front.
+             - REORDER_RCM: reverse Cuthill-McKee, i.e. a BFS per component starting
+               at a minimum-degree vertex with neighbors taken by ascending degree,
+               then reversed; neighbors end up with nearby indices.
 */
+void computeVertexOrder(const GraphCSR* csr, ReorderMode mode, int order[]) {
+    int n = csr->numVertices;
+    int maxDeg = 0;
+    int i;
 
-void ProduceSetsFile(const Graph* g, const char* inputFilename)
-{
-    char outputFilename[MAX_FILE_NAME_LEN];
-    FILE* fp = NULL;
-    int i = 0;
-	int firstPrinted = 1;
-    
-    // Copy input filename and remove extension
-    strcpy(outputFilename, inputFilename);
-    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
-        i++;
+    for (i = 0; i < n; i++) {
+        int d = csr->offsets[i + 1] - csr->offsets[i];
+        if (d > maxDeg) {
+            maxDeg = d;
+        }
     }
-    outputFilename[i] = '\0'; // Truncate at '.' or end
-    
-    // Append suffix
-    strcat(outputFilename, "-SET.TXT");
 
-    fp = fopen(outputFilename, "w");
+    // stable counting sort of the vertices by degree (ascending)
+    int* bucket = calloc(maxDeg + 2, sizeof(int));
+    int* byDegree = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (bucket == NULL || byDegree == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (i = 0; i < n; i++) {
+        bucket[csr->offsets[i + 1] - csr->offsets[i] + 1]++;
+    }
+    for (i = 1; i <= maxDeg + 1; i++) {
+        bucket[i] += bucket[i - 1];
+    }
+    for (i = 0; i < n; i++) {
+        int d = csr->offsets[i + 1] - csr->offsets[i];
+        byDegree[bucket[d]] = i;
+        bucket[d]++;
+    }
+    free(bucket);
 
-    if (fp != NULL)
-	{
-		int count = g->numVertices;	
-		int sortedVertex[count];
- 
-        for (i = 0; i < count; i++) 
-            sortedVertex[i] = i;		
+    if (mode == REORDER_DEGREE) {
+        // walk the degree buckets from the top, keeping input order within a degree
+        int k = 0;
+        int hi = n - 1;
+        while (hi >= 0) {
+            int d = csr->offsets[byDegree[hi] + 1] - csr->offsets[byDegree[hi]];
+            int lo = hi;
+            while (lo > 0 && csr->offsets[byDegree[lo - 1] + 1] - csr->offsets[byDegree[lo - 1]] == d) {
+                lo--;
+            }
+            for (i = lo; i <= hi; i++) {
+                order[k] = byDegree[i];
+                k++;
+            }
+            hi = lo - 1;
+        }
+    } else {
+        int* visited = calloc(n > 0 ? n : 1, sizeof(int));
+        if (visited == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        int rear = 0;
+        for (int s = 0; s < n; s++) {
+            int root = byDegree[s];
+            if (!visited[root]) {
+                // order[] doubles as the BFS queue
+                int front = rear;
+                visited[root] = 1;
+                order[rear] = root;
+                rear++;
+                while (front < rear) {
+                    int v = order[front];
+                    front++;
+                    int first = rear;
+                    for (int e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+                        int u = csr->neighbors[e];
+                        if (!visited[u]) {
+                            visited[u] = 1;
+                            order[rear] = u;
+                            rear++;
+                        }
+                    }
+                    // insertion sort the newly queued neighbors by degree
+                    for (int a = first + 1; a < rear; a++) {
+                        int u = order[a];
+                        int du = csr->offsets[u + 1] - csr->offsets[u];
+                        int b = a - 1;
+                        while (b >= first && csr->offsets[order[b] + 1] - csr->offsets[order[b]] > du) {
+                            order[b + 1] = order[b];
+                            b--;
+                        }
+                        order[b + 1] = u;
+                    }
+                }
+            }
+        }
+        // reverse Cuthill-McKee
+        for (i = 0; i < n / 2; i++) {
+            int temp = order[i];
+            order[i] = order[n - 1 - i];
+            order[n - 1 - i] = temp;
+        }
+        free(visited);
+    }
+    free(byDegree);
+}
 
-		// selection sort for solely the vertices
-		for (i = 0; i < count - 1; i++) 
-		{
-			int min = i;
-			for (int j = i + 1; j < count; j++) 
-			{
-				const char* nameJ = g->adjList[sortedVertex[j]].head->vertexName;
-				const char* nameMin = g->adjList[sortedVertex[min]].head->vertexName;
+/**
+    Purpose: Renumbers the vertices of a graph for memory locality.
+    Returns: 1 if successful; 0 if the graph has no vertices to reorder.
+    @param  : g    - pointer to the Graph to reorder in place
+    @param  : mode - REORDER_DEGREE or REORDER_RCM
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data.
+    Post-condition:
+             - adjList is permuted and every list is rebuilt in the new vertex
+               order, so consecutive vertices' nodes are allocated together.
+             - g->inputOrder maps input-file positions to the new indices, so
+               reports that print in file order (LIST, MATRIX) are unchanged.
+             - The label index, if present, is rebuilt for the new indices.
+             - Program exits on malloc failure.
+*/
+int ReorderGraph(Graph* g, ReorderMode mode) {
+    int n = g->numVertices;
+    if (n == 0) {
+        return 0;
+    }
 
-				if (strcmp(nameJ, nameMin) < 0) 
-					min = j; 
-			}
+    GraphCSR* csr = buildCSR(g);
+    int* order = malloc(n * sizeof(int));
+    int* newIndex = malloc(n * sizeof(int));
+    int* inputOrder = malloc(n * sizeof(int));
+    List* newAdj = calloc(n, sizeof(List));
+    if (order == NULL || newIndex == NULL || inputOrder == NULL || newAdj == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    computeVertexOrder(csr, mode, order);
+    csr = freeCSR(csr);
 
-			if (min != i) 
-			{
-				int temp = sortedVertex[i];
-				sortedVertex[i] = sortedVertex[min];
-				sortedVertex[min] = temp;
-			}
-		}
-			
-		// Printing the set of vertices.
-		fprintf(fp, "V(G)={");
+    int i;
+    for (i = 0; i < n; i++) {
+        newIndex[order[i]] = i;
+    }
 
-		for (i = 0; i < g->numVertices; i++)
-		{
-			if (firstPrinted)	
-				firstPrinted = 0;	
-			else
-				fprintf(fp, ",");	
-				
-			fprintf(fp, "%s", g->adjList[sortedVertex[i]].head->vertexName);	
-		}
-		fprintf(fp, "}\n");
+    // rebuild each list at its new slot, freeing the old chain as we go
+    for (i = 0; i < n; i++) {
+        List* old = &g->adjList[order[i]];
+        initList(&newAdj[i]);
+        Node* cur = old->head;
+        while (cur != NULL) {
+            appendNode(&newAdj[i], cur->label);
+            cur = cur->edge;
+        }
+        freeList(old);
+    }
+    free(g->adjList);
+    g->adjList = newAdj;
 
-		// Printing the set of edges.
-		fprintf(fp, "E(G)={");
+    // compose with any earlier reordering so file positions stay correct
+    for (i = 0; i < n; i++) {
+        inputOrder[i] = newIndex[vertexAtInputPos(g, i)];
+    }
+    free(g->inputOrder);
+    g->inputOrder = inputOrder;
 
-		int visited[count][count];
-		memset(visited, 0, sizeof(visited)); // sets all values of adjacency matrix to 0
+    // vertex indices moved, so the label index must be rebuilt
+    if (g->labelVertex != NULL) {
+        buildLabelIndex(g);
+    }
 
-		firstPrinted = 1;
+    free(order);
+    free(newIndex);
+    return 1;
+}
 
-		for (i = 0; i < count; i++)
-		{	
-			Node* neighbor = g->adjList[sortedVertex[i]].head->edge;
+/**
+    Purpose: Counts the set bits in a 64-bit word.
+    Returns: Number of 1 bits in w
+    @param  : w - word to count
+*/
+int popcount64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(w);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int) ((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
 
-			if (neighbor != NULL)
-			{	
-				int sortedNeighbors[count];	
-				int neighborCount = getSortedNeighbors(g, sortedVertex[i], sortedNeighbors);
+/**
+    Purpose: Finds the position of the lowest set bit of a word.
+    Returns: 0..63
+    @param  : w - nonzero word
+*/
+int lowestBit64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(w);
+#else
+    int bit = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
 
-				for (int j = 0; j < neighborCount; j++)
-				{
-					if (visited[sortedVertex[i]][sortedNeighbors[j]] == 0)
-					{
-						if (firstPrinted)	
-							firstPrinted = 0;	
-						else
-							fprintf(fp, ",");						
+/**
+    Purpose: Decides whether a graph is dense enough for the bit-matrix form to pay off.
+    Returns: 1 if V^2 bits take no more room than the adjacency entries as ints; 0 otherwise
+    @param  : g - pointer to the Graph
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data.
+*/
+int isDenseGraph(const Graph* g) {
+    long long entries = 0;
+    for (int i = 0; i < g->numVertices; i++) {
+        Node* cur = g->adjList[i].head->edge;
+        while (cur != NULL) {
+            entries++;
+            cur = cur->edge;
+        }
+    }
+    return (long long) g->numVertices * g->numVertices <= entries * 32;
+}
 
-						fprintf(fp, "(%s,", g->adjList[sortedVertex[i]].head->vertexName);		
-						fprintf(fp, "%s)", g->adjList[sortedNeighbors[j]].head->vertexName);	
+/**
+    Purpose: Allocates an all-zero V x V bit matrix with 64-bit aligned rows.
+    Returns: Pointer to the new BitMatrix
+    @param  : numVertices - number of rows and columns
+    Post-condition:
+             - Every bit is 0; each row starts on its own 64-bit word.
+             - Program exits on malloc failure.
+*/
+BitMatrix* createBitMatrix(int numVertices) {
+    BitMatrix* m = malloc(sizeof(BitMatrix));
+    if (m == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    m->numVertices = numVertices;
+    m->wordsPerRow = (numVertices + 63) / 64;
+    m->uniqueLabels = 1;
+    size_t words = (size_t) numVertices * m->wordsPerRow;
+    m->bits = calloc(words > 0 ? words : 1, sizeof(uint64_t));
+    if (m->bits == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    return m;
+}
 
-						visited[sortedVertex[i]][sortedNeighbors[j]] = 1; 
-						visited[sortedNeighbors[j]][sortedVertex[i]] = 1; 
-					}	
+/**
+    Purpose: Builds the bit-matrix form of a graph's adjacency lists.
+    Returns: Pointer to the new BitMatrix
+    @param  : g - pointer to the Graph
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data.
+    Post-condition:
+             - Bit (u, v) is set iff v's label appears in u's adjacency list.
+             - m->uniqueLabels is cleared if two vertices share a label; the
+               label's entries then only set the bit of its lowest vertex.
+*/
+BitMatrix* buildBitMatrix(const Graph* g) {
+    BitMatrix* m = createBitMatrix(g->numVertices);
+    for (int u = 0; u < g->numVertices; u++) {
+        if (nodeVertex(g, g->adjList[u].head) != u) {
+            m->uniqueLabels = 0;
+        }
+        Node* cur = g->adjList[u].head->edge;
+        while (cur != NULL) {
+            int v = nodeVertex(g, cur);
+            if (v >= 0) {
+                setBit(m, u, v);
+            }
+            cur = cur->edge;
+        }
+    }
+    return m;
+}
 
-				}
-			}	
-				
+/**
+    Purpose: Frees a BitMatrix.
+    Returns: NULL
+    @param  : m - pointer to the BitMatrix to free
+    Post-condition:
+             - Returns NULL so caller can safely do: m = freeBitMatrix(m);
+*/
+BitMatrix* freeBitMatrix(BitMatrix* m) {
+    if (m != NULL) {
+        free(m->bits);
+        free(m);
+    }
+    return NULL;
+}
 
-		}		
+/**
+    Purpose: Sets bit (u, v) of a bit matrix.
+    Returns: void
+    @param  : m - pointer to the BitMatrix
+    @param  : u - row index
+    @param  : v - column index
+*/
+void setBit(BitMatrix* m, int u, int v) {
+    m->bits[(size_t) u * m->wordsPerRow + v / 64] |= (uint64_t) 1 << (v % 64);
+}
 
-		fprintf(fp, "}\n");
+/**
+    Purpose: O(1) edge-existence check.
+    Returns: 1 if bit (u, v) is set; 0 otherwise
+    @param  : m - pointer to the BitMatrix
+    @param  : u - row index
+    @param  : v - column index
+*/
+int hasEdge(const BitMatrix* m, int u, int v) {
+    return (int) ((m->bits[(size_t) u * m->wordsPerRow + v / 64] >> (v % 64)) & 1);
+}
 
-		fclose(fp);
-	}
+/**
+    Purpose: Computes a vertex's degree as the popcount of its row.
+    Returns: Number of distinct neighbors of v
+    @param  : m - pointer to the BitMatrix
+    @param  : v - row index
+*/
+int bitRowDegree(const BitMatrix* m, int v) {
+    const uint64_t* row = m->bits + (size_t) v * m->wordsPerRow;
+    int degree = 0;
+    for (int w = 0; w < m->wordsPerRow; w++) {
+        degree += popcount64(row[w]);
+    }
+    return degree;
 }
 
 /**
-    Purpose: Generates a vertex degree report file (<input>-DEGREE.TXT).
+    Purpose: Level-synchronous BFS over a bit matrix, expanding whole frontiers a word at a time.
+    Returns: Number of vertices reached (including start)
+    @param  : m     - pointer to the BitMatrix
+    @param  : start - index of the start vertex
+    @param  : level - output array; level[v] = hop distance from start, -1 if unreached
+    Pre-condition:
+             - 0 <= start < m->numVertices; level holds m->numVertices ints.
+    Post-condition:
+             - Each level costs O(|frontier| * V/64): the next frontier is the OR of
+               the frontier rows with the visited set masked out.
+*/
+int bitMatrixBFS(const BitMatrix* m, int start, int level[]) {
+    int W = m->wordsPerRow;
+    uint64_t* frontier = calloc(W > 0 ? W : 1, sizeof(uint64_t));
+    uint64_t* next = calloc(W > 0 ? W : 1, sizeof(uint64_t));
+    uint64_t* visited = calloc(W > 0 ? W : 1, sizeof(uint64_t));
+    if (frontier == NULL || next == NULL || visited == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    for (int v = 0; v < m->numVertices; v++) {
+        level[v] = -1;
+    }
+    level[start] = 0;
+    frontier[start / 64] |= (uint64_t) 1 << (start % 64);
+    visited[start / 64] |= (uint64_t) 1 << (start % 64);
+
+    int reached = 1;
+    int depth = 0;
+    int active = 1;
+    while (active) {
+        int w;
+        memset(next, 0, W * sizeof(uint64_t));
+
+        // OR together the rows of every frontier vertex
+        for (w = 0; w < W; w++) {
+            uint64_t bitsLeft = frontier[w];
+            while (bitsLeft != 0) {
+                int u = w * 64 + lowestBit64(bitsLeft);
+                const uint64_t* row = m->bits + (size_t) u * W;
+                for (int k = 0; k < W; k++) {
+                    next[k] |= row[k];
+                }
+                bitsLeft &= bitsLeft - 1;
+            }
+        }
+
+        // keep only unvisited vertices; they form the next frontier
+        depth++;
+        active = 0;
+        for (w = 0; w < W; w++) {
+            next[w] &= ~visited[w];
+            visited[w] |= next[w];
+            frontier[w] = next[w];
+            uint64_t bitsLeft = next[w];
+            while (bitsLeft != 0) {
+                level[w * 64 + lowestBit64(bitsLeft)] = depth;
+                reached++;
+                active = 1;
+                bitsLeft &= bitsLeft - 1;
+            }
+        }
+    }
+
+    free(frontier);
+    free(next);
+    free(visited);
+    return reached;
+}
+
+/**
+    Purpose: Fills a TraversalLimits with "no limit" values.
+    Returns: void
+    @param  : lim - pointer to the limits to reset
+    Pre-condition:
+        - lim must not be NULL
+    Post-condition:
+        - maxDepth, target and maxVisits are all -1 (unbounded)
+*/
+void initTraversalLimits(TraversalLimits* lim) {
+    lim->maxDepth = -1;
+    lim->target = -1;
+    lim->maxVisits = -1;
+}
+
+/**
+    Purpose: Reports a newly visited vertex and decides whether the traversal must stop.
+    Returns: TRAV_EXHAUSTED to keep going; otherwise the reason to stop
+    @param  : g      - pointer to the Graph
+    @param  : vIndex - index of the vertex just visited
+    @param  : depth  - depth of vIndex in the traversal tree
+    @param  : count  - number of vertices visited so far, including vIndex
+    @param  : lim    - traversal limits (may be NULL)
+    @param  : visit  - visitor callback (may be NULL)
+    @param  : ctx    - caller data passed through to visit
+    Pre-condition:
+        - g must not be NULL
+*/
+TraversalStop checkVisitStop(const Graph* g, int vIndex, int depth, int count,
+                             const TraversalLimits* lim, VertexVisitor visit, void* ctx) {
+    if (visit != NULL && visit(g, vIndex, depth, ctx)) {
+        return TRAV_VISITOR;
+    }
+    if (lim != NULL && lim->target == vIndex) {
+        return TRAV_TARGET_FOUND;
+    }
+    if (lim != NULL && lim->maxVisits >= 0 && count >= lim->maxVisits) {
+        return TRAV_BUDGET;
+    }
+    return TRAV_EXHAUSTED;
+}
+
+/**
+    Purpose: Depth-first search that stops early on a depth limit, target vertex or visit budget.
+    Returns: Why the traversal ended (see TraversalStop)
+    @param  : g            - pointer to the Graph
+    @param  : start        - index of the start vertex
+    @param  : lim          - traversal limits (NULL = unbounded)
+    @param  : visit        - callback invoked for each vertex in DFS order (may be NULL)
+    @param  : ctx          - caller data passed through to visit
+    @param  : visitedCount - receives the number of vertices visited (may be NULL)
+    Pre-condition:
+        - g must not be NULL
+        - 0 <= start < g->numVertices
+    Post-condition:
+        - With maxDepth set, only vertices whose DFS tree depth is <= maxDepth are
+          visited; TRAV_DEPTH_LIMIT is returned only if a reachable vertex was
+          left out entirely (not merely cut on one path and reached on another).
+        - Iterative, so no recursion. Bounded queries keep the visited set in a
+          SparseVertexMap and cost only what they visit; full traversals use a
+          V-sized array (see initVisitedSet).
+        - maxVisits = 0 visits nothing and returns TRAV_BUDGET.
+*/
+TraversalStop DFSBounded(const Graph* g, int start, const TraversalLimits* lim,
+                         VertexVisitor visit, void* ctx, int* visitedCount) {
+    if (lim != NULL && lim->maxVisits == 0) {
+        if (visitedCount != NULL) {
+            *visitedCount = 0;
+        }
+        return TRAV_BUDGET;
+    }
+    VisitedSet seen;
+    int frameCap = 16, pendingCap = 64, rowCap = 16, cutCap = 16;
+    DFSFrame* frames = malloc(frameCap * sizeof(DFSFrame));
+    int* pending = malloc(pendingCap * sizeof(int));
+    KeyIndex* row = malloc(rowCap * sizeof(KeyIndex));
+    int* cut = malloc(cutCap * sizeof(int));   // vertices skipped at maxDepth
+    if (frames == NULL || pending == NULL || row == NULL || cut == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    initVisitedSet(&seen, g->numVertices, isBoundedTraversal(g, lim));
+
+    int maxDepth = (lim != NULL) ? lim->maxDepth : -1;
+    int top = 0, pendingTop = 0, count = 0, numCut = 0, i;
+    int v = start;
+    TraversalStop stop = TRAV_EXHAUSTED;
+    while (v >= 0 && stop == TRAV_EXHAUSTED) {
+        // enter v at depth top: report it, then push its sorted neighbors
+        visitedPut(&seen, v, top);
+        count++;
+        stop = checkVisitStop(g, v, top, count, lim, visit, ctx);
+        if (stop == TRAV_EXHAUSTED) {
+            int cnt = sortedNeighborRow(g, v, &row, &rowCap);
+            if (maxDepth >= 0 && top >= maxDepth) {
+                // reachable, but beyond maxDepth on this path
+                for (i = 0; i < cnt; i++) {
+                    if (visitedGet(&seen, row[i].index) < 0) {
+                        if (numCut == cutCap) {
+                            cutCap *= 2;
+                            cut = realloc(cut, cutCap * sizeof(int));
+                            if (cut == NULL) {
+                                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                                exit(1);
+                            }
+                        }
+                        cut[numCut] = row[i].index;
+                        numCut++;
+                    }
+                }
+                cnt = 0;
+            }
+            if (top == frameCap || pendingTop + cnt > pendingCap) {
+                frameCap *= 2;
+                while (pendingTop + cnt > pendingCap) {
+                    pendingCap *= 2;
+                }
+                frames = realloc(frames, frameCap * sizeof(DFSFrame));
+                pending = realloc(pending, pendingCap * sizeof(int));
+                if (frames == NULL || pending == NULL) {
+                    fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                    exit(1);
+                }
+            }
+            for (i = 0; i < cnt; i++) {
+                pending[pendingTop + i] = row[i].index;
+            }
+            frames[top].begin = pendingTop;
+            frames[top].next = pendingTop;
+            frames[top].end = pendingTop + cnt;
+            pendingTop += cnt;
+            top++;
+
+            // find the next unvisited vertex, popping exhausted frames
+            v = -1;
+            while (v < 0 && top > 0) {
+                DFSFrame* f = &frames[top - 1];
+                while (f->next < f->end && visitedGet(&seen, pending[f->next]) >= 0) {
+                    f->next++;
+                }
+                if (f->next < f->end) {
+                    v = pending[f->next];
+                    f->next++;
+                } else {
+                    pendingTop = f->begin;
+                    top--;
+                }
+            }
+        }
+    }
+    for (i = 0; i < numCut && stop == TRAV_EXHAUSTED; i++) {
+        if (visitedGet(&seen, cut[i]) < 0) {
+            stop = TRAV_DEPTH_LIMIT;
+        }
+    }
+
+    // clean up
+    freeVisitedSet(&seen);
+    free(frames);
+    free(pending);
+    free(row);
+    free(cut);
+    if (visitedCount != NULL) {
+        *visitedCount = count;
+    }
+    return stop;
+}
+
+/**
+    Purpose: Breadth-first search that stops early on a depth limit, target vertex or visit budget.
+    Returns: Why the traversal ended (see TraversalStop)
+    @param  : g            - pointer to the Graph
+    @param  : start        - index of the start vertex
+    @param  : lim          - traversal limits (NULL = unbounded)
+    @param  : visit        - callback invoked for each vertex in BFS order (may be NULL)
+    @param  : ctx          - caller data passed through to visit
+    @param  : visitedCount - receives the number of vertices visited (may be NULL)
+    Pre-condition:
+        - g must not be NULL
+        - 0 <= start < g->numVertices
+    Post-condition:
+        - With maxDepth = k, exactly the vertices within k hops of start are visited;
+          TRAV_DEPTH_LIMIT is returned if some vertex lies further away.
+        - The visited set (vertex -> depth) is a SparseVertexMap for bounded
+          queries, so their cost follows what is visited, and a V-sized array
+          for full traversals (see initVisitedSet). The queue grows as needed.
+        - maxVisits = 0 visits nothing and returns TRAV_BUDGET.
+*/
+TraversalStop BFSBounded(const Graph* g, int start, const TraversalLimits* lim,
+                         VertexVisitor visit, void* ctx, int* visitedCount) {
+    if (lim != NULL && lim->maxVisits == 0) {
+        if (visitedCount != NULL) {
+            *visitedCount = 0;
+        }
+        return TRAV_BUDGET;
+    }
+    VisitedSet seen;
+    int queueCap = 64, rowCap = 16;
+    int* queue = malloc(queueCap * sizeof(int));
+    KeyIndex* row = malloc(rowCap * sizeof(KeyIndex));
+    if (queue == NULL || row == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    initVisitedSet(&seen, g->numVertices, isBoundedTraversal(g, lim));
+
+    int front = 0, rear = 0;
+    int count = 0;
+    int truncated = 0;
+    int maxDepth = (lim != NULL) ? lim->maxDepth : -1;
+    TraversalStop stop = TRAV_EXHAUSTED;
+
+    // enqueue the start vertex
+    visitedPut(&seen, start, 0);
+    queue[rear] = start;
+    rear++;
+
+    // process queue
+    while (front < rear && stop == TRAV_EXHAUSTED) {
+        int v = queue[front];
+        int depth = visitedGet(&seen, v);
+        front++;
+        count++;
+        stop = checkVisitStop(g, v, depth, count, lim, visit, ctx);
+        if (stop == TRAV_EXHAUSTED) {
+            // get sorted neighbor indices
+            int cnt = sortedNeighborRow(g, v, &row, &rowCap);
+            for (int i = 0; i < cnt; i++) {
+                int u = row[i].index;
+                if (visitedGet(&seen, u) < 0) {
+                    if (maxDepth >= 0 && depth >= maxDepth) {
+                        // BFS reaches vertices in depth order, so u is never reached
+                        truncated = 1;
+                    } else {
+                        if (rear == queueCap) {
+                            queueCap *= 2;
+                            queue = realloc(queue, queueCap * sizeof(int));
+                            if (queue == NULL) {
+                                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                                exit(1);
+                            }
+                        }
+                        visitedPut(&seen, u, depth + 1);
+                        queue[rear] = u;
+                        rear++;
+                    }
+                }
+            }
+        }
+    }
+    if (stop == TRAV_EXHAUSTED && truncated) {
+        stop = TRAV_DEPTH_LIMIT;
+    }
+
+    // clean up
+    freeVisitedSet(&seen);
+    free(queue);
+    free(row);
+    if (visitedCount != NULL) {
+        *visitedCount = count;
+    }
+    return stop;
+}
+
+/**
+    Purpose: Streams a depth-first search from a vertex index to a visitor callback.
+    Returns: Number of vertices visited (including the one the visitor stopped on)
+    @param  : g     - pointer to the Graph
+    @param  : start - index of the start vertex
+    @param  : visit - callback invoked for each vertex in DFS order (may be NULL)
+    @param  : ctx   - caller data passed through to visit
+    Pre-condition:
+        - g must not be NULL
+        - 0 <= start < g->numVertices
+    Post-condition:
+        - No per-vertex labels are copied; consumers decide what to keep.
+*/
+int DFSVisit(const Graph* g, int start, VertexVisitor visit, void* ctx) {
+    int count = 0;
+    DFSBounded(g, start, NULL, visit, ctx, &count);
+    return count;
+}
+
+/**
+    Purpose: Streams a breadth-first search from a vertex index to a visitor callback.
+    Returns: Number of vertices visited (including the one the visitor stopped on)
+    @param  : g     - pointer to the Graph
+    @param  : start - index of the start vertex
+    @param  : visit - callback invoked for each vertex in BFS order (may be NULL)
+    @param  : ctx   - caller data passed through to visit
+    Pre-condition:
+        - g must not be NULL
+        - 0 <= start < g->numVertices
+    Post-condition:
+        - No per-vertex labels are copied; consumers decide what to keep.
+*/
+int BFSVisit(const Graph* g, int start, VertexVisitor visit, void* ctx) {
+    int count = 0;
+    BFSBounded(g, start, NULL, visit, ctx, &count);
+    return count;
+}
+
+/**
+    Purpose: Visitor that stores each visited vertex label in a TraversalCollector.
+    Returns: 0 (never stops the traversal)
+    @param  : g      - pointer to the Graph
+    @param  : vIndex - index of the visited vertex
+    @param  : depth  - unused
+    @param  : ctx    - pointer to a TraversalCollector
+*/
+int collectVisitor(const Graph* g, int vIndex, int depth, void* ctx) {
+    TraversalCollector* c = ctx;
+    (void) depth;
+    c->traversal[c->count] = vertexLabel(g, vIndex);
+    c->count++;
+    return 0;
+}
+
+/**
+    Purpose: Visitor that writes each visited vertex label straight to a file, space separated.
+    Returns: 0 (never stops the traversal)
+    @param  : g      - pointer to the Graph
+    @param  : vIndex - index of the visited vertex
+    @param  : depth  - unused
+    @param  : ctx    - pointer to a TraversalWriter
+*/
+int writeVisitor(const Graph* g, int vIndex, int depth, void* ctx) {
+    TraversalWriter* w = ctx;
+    (void) depth;
+    if (w->count > 0) {
+        fputc(' ', w->fp);
+    }
+    fputs(vertexLabel(g, vIndex), w->fp);
+    w->count++;
+    return 0;
+}
+
+/**
+    Purpose: Performs a depth-first search starting from a given vertex name.
+    Returns: Number of vertices traversed
+    @param  : g         - pointer to the Graph
+    @param  : startName - name of the start vertex
+    @param  : traversal - array to fill with the labels in DFS visit order (owned by g)
+    Pre-condition:
+        - g and traversal must not be NULL
+        - traversal array size >= g->numVertices
+        - startName must correspond to an existing vertex
+    Post-condition:
+        - traversal[0..n-1] holds the DFS order; n = number of reachable vertices
+*/
+int DFS(const Graph* g, const char* startName, const char* traversal[]) {
+    // find the start vertex
+    int start = getVertexIndex(g, startName);
+    if (start < 0) {
+        fprintf(stderr, "Vertex %s not found", startName);
+        exit(1);
+    }
+
+    TraversalCollector c = { traversal, 0 };
+    DFSVisit(g, start, collectVisitor, &c);
+    return c.count;
+}
+
+/**
+        Purpose: Performs a breadth-first search starting from a given vertex name and records order in traversal[].
+        Returns: Number of vertices traversed
+        @param  : g         - pointer to the Graph
+        @param  : startName - name of the start vertex
+        @param  : traversal - array to fill with the labels in BFS visit order (owned by g)
+        Pre-condition:
+            - g and traversal must not be NULL
+            - traversal array size >= g->numVertices
+            - startName corresponds to an existing vertex
+        Post-condition:
+            - traversal[0..n-1] holds the BFS order; n = number of reachable vertices
+*/
+int BFS(const Graph* g, const char* startName, const char* traversal[]) {
+    // find start vertex index
+    int start = getVertexIndex(g, startName);
+    if (start < 0) {
+        fprintf(stderr, "Vertex %s not found", startName);
+        exit(1);
+    }
+
+    TraversalCollector c = { traversal, 0 };
+    BFSVisit(g, start, collectVisitor, &c);
+    return c.count;
+}
+
+/**
+    Purpose: Generates a file that contains the set of vertices and the set of edges. (<input>-SET.TXT).
     Returns: void
     @param  : g             - pointer to the Graph
     @param  : inputFilename - name of the input file (e.g., "G.TXT")
     Pre-condition:
              - g must not be NULL and must contain valid graph data
+			 - g is an UNDIRECTED graph.
              - inputFilename must be a valid null-terminated string
 */
-void ProduceDegreeFile(const Graph* g, const char* inputFilename) {
+
+void ProduceSetsFile(const Graph* g, const char* inputFilename)
+{
     char outputFilename[MAX_FILE_NAME_LEN];
+    FILE* fp = NULL;
     int i = 0;
-    int j = 0;
+	int firstPrinted = 1;
     
-    // Create filename
+    // Copy input filename and remove extension
     strcpy(outputFilename, inputFilename);
     while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
         i++;
     }
-    outputFilename[i] = '\0';  // Truncate at '.' or end
-    strcat(outputFilename, "-DEGREE.TXT");
-    
-    // Open file for writing
-    FILE* fp = fopen(outputFilename, "w");
+    outputFilename[i] = '\0'; // Truncate at '.' or end
     
-    // Process data
-    if (fp != NULL) {
+    // Append suffix
+    strcat(outputFilename, "-SET.TXT");
 
-        // Array of vertex-degree pairs
-        VertexDegree vd[g->numVertices];
-        
-        // Calculate degrees
-        for (i = 0; i < g->numVertices; i++) {
-            strcpy(vd[i].name, g->adjList[i].head->vertexName);
-            vd[i].degree = 0;
-            
-            Node* neighbor = g->adjList[i].head->edge;
-            int neighborExists = (neighbor != NULL);
-            while (neighborExists) {
-                vd[i].degree++;
-                neighbor = neighbor->edge;
-                neighborExists = (neighbor != NULL);
-            }
-        }
-        
-        // Sort
+    fp = fopen(outputFilename, "w");
+
+    if (fp != NULL)
+	{
+		int count = g->numVertices;	
+		int sortedVertex[count];
+ 
+        for (i = 0; i < count; i++) 
+            sortedVertex[i] = i;		
+
+		// selection sort for solely the vertices
+		for (i = 0; i < count - 1; i++) 
+		{
+			int min = i;
+			for (int j = i + 1; j < count; j++) 
+			{
+				LabelKey keyJ = vertexKey(g, sortedVertex[j]);
+				LabelKey keyMin = vertexKey(g, sortedVertex[min]);
+
+				if (keyJ < keyMin) 
+					min = j; 
+			}
+
+			if (min != i) 
+			{
+				int temp = sortedVertex[i];
+				sortedVertex[i] = sortedVertex[min];
+				sortedVertex[min] = temp;
+			}
+		}
+			
+		// Printing the set of vertices.
+		fprintf(fp, "V(G)={");
+
+		for (i = 0; i < g->numVertices; i++)
+		{
+			if (firstPrinted)	
+				firstPrinted = 0;	
+			else
+				fprintf(fp, ",");	
+				
+			fprintf(fp, "%s", vertexLabel(g, sortedVertex[i]));	
+		}
+		fprintf(fp, "}\n");
+
+		// Printing the set of edges.
+		fprintf(fp, "E(G)={");
+
+		// one bit per vertex pair marks edges already printed
+		BitMatrix* printed = createBitMatrix(count);
+
+		// one neighbor row on the heap, grown as needed and reused for every vertex
+		int rowCap = 16;
+		KeyIndex* sortedNeighbors = malloc(rowCap * sizeof(KeyIndex));
+		if (sortedNeighbors == NULL) {
+			fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+			exit(1);
+		}
+
+		firstPrinted = 1;
+
+		for (i = 0; i < count; i++)
+		{	
+			Node* neighbor = g->adjList[sortedVertex[i]].head->edge;
+
+			if (neighbor != NULL)
+			{	
+				int neighborCount = sortedNeighborRow(g, sortedVertex[i], &sortedNeighbors, &rowCap);
+
+				for (int j = 0; j < neighborCount; j++)
+				{
+					int u = sortedNeighbors[j].index;
+					if (!hasEdge(printed, sortedVertex[i], u))
+					{
+						if (firstPrinted)	
+							firstPrinted = 0;	
+						else
+							fprintf(fp, ",");						
+
+						fprintf(fp, "(%s,", vertexLabel(g, sortedVertex[i]));		
+						fprintf(fp, "%s)", vertexLabel(g, u));	
+
+						setBit(printed, sortedVertex[i], u);
+						setBit(printed, u, sortedVertex[i]);
+					}	
+
+				}
+			}	
+				
+
+		}		
+
+		fprintf(fp, "}\n");
+
+		printed = freeBitMatrix(printed);
+		free(sortedNeighbors);
+		fclose(fp);
+	}
+}
+
+/**
+    Purpose: Generates a vertex degree report file (<input>-DEGREE.TXT).
+    Returns: void
+    @param  : g             - pointer to the Graph
+    @param  : inputFilename - name of the input file (e.g., "G.TXT")
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+             - inputFilename must be a valid null-terminated string
+*/
+void ProduceDegreeFile(const Graph* g, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN];
+    int i = 0;
+    int j = 0;
+    
+    // Create filename
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0';  // Truncate at '.' or end
+    strcat(outputFilename, "-DEGREE.TXT");
+    
+    // Open file for writing
+    FILE* fp = fopen(outputFilename, "w");
+    
+    // Process data
+    if (fp != NULL) {
+
+        // Array of vertex-degree pairs
+        VertexDegree vd[g->numVertices];
+
+        // Calculate degrees, in input-file order so the stable sort below
+        // keeps vertices sharing a label in file order
+        for (i = 0; i < g->numVertices; i++) {
+            int v = vertexAtInputPos(g, i);
+            vd[i].name = vertexLabel(g, v);
+            vd[i].key = vertexKey(g, v);
+            vd[i].degree = 0;
+
+            Node* neighbor = g->adjList[v].head->edge;
+            int neighborExists = (neighbor != NULL);
+            while (neighborExists) {
+                vd[i].degree++;
+                neighbor = neighbor->edge;
+                neighborExists = (neighbor != NULL);
+            }
+        }
+        
+        // Sort
         int sortingComplete = 0;
         for (i = 0; i < g->numVertices - 1 && !sortingComplete; i++) {
             sortingComplete = 1;  // Flagger
             
             for (j = 0; j < g->numVertices - i - 1; j++) {
-                int shouldSwap = (strcmp(vd[j].name, vd[j+1].name) > 0);
+                int shouldSwap = (vd[j].key > vd[j+1].key);
                 if (shouldSwap) {
                     VertexDegree temp = vd[j];
                     vd[j] = vd[j+1];
@@ -622,253 +2413,3948 @@ void ProduceDegreeFile(const Graph* g, const char* inputFilename) {
                 }
             }
         }
-        
-        // Print sorted vertex degrees
-        for (i = 0; i < g->numVertices; i++) {
-            fprintf(fp, "%s %d\n", vd[i].name, vd[i].degree);
-        } 
-        fclose(fp);
+        
+        // Print sorted vertex degrees
+        for (i = 0; i < g->numVertices; i++) {
+            fprintf(fp, "%s %d\n", vd[i].name, vd[i].degree);
+        } 
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: Generates a file that represents an adjacency list of the graph (<input>-LIST.TXT).
+    Returns: void
+    @param  : g             - pointer to the Graph
+    @param  : inputFilename - name of the input file
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+             - inputFilename must be a valid null-terminated string
+*/
+void ProduceListFile(const Graph* g, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN];
+    FILE* fp = NULL;
+    int i = 0;
+    
+    // Copy input filename and remove extension
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0'; // Truncate at '.' or end
+    
+    // Append suffix
+    strcat(outputFilename, "-LIST.TXT");
+    
+    fp = fopen(outputFilename, "w");
+
+    if (fp != NULL) 
+	{
+		for (i = 0; i < g->numVertices; i++)
+		{
+			int v = vertexAtInputPos(g, i);   // print in input-file order
+
+			// vertex	
+			fprintf(fp, "%s", vertexLabel(g, v));
+
+			// edges
+			Node* neighbor = g->adjList[v].head->edge;
+
+			while (neighbor != NULL)
+			{
+				fprintf(fp, "->");
+
+				fprintf(fp,"%s", labelText(g->labels, neighbor->label));	
+
+				neighbor = neighbor->edge;			
+			}
+
+			fprintf(fp, "->\\\n");
+		}	
+
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: A helper function for ProduceMatrixFile for proper spacing
+    Returns: Maximum length of vertex names plus padding
+    @param  : g             - pointer to the Graph
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+*/
+
+int matrixHelper(const Graph* g)
+{
+    int maxNameLen = 0;
+    for (int i = 0; i < g->numVertices; i++) {
+        int currentLen = (int) g->labels->refs[g->adjList[i].head->label].length;
+        if (currentLen > maxNameLen) {
+            maxNameLen = currentLen;
+        }
+    }
+    maxNameLen += 2; // Adds padding
+
+    return maxNameLen;
+}
+
+/**
+    Purpose: Generates an adjacency matrix file (<input>-MATRIX.TXT).
+    Returns: void
+    @param  : g             - pointer to the Graph
+    @param  : inputFilename - name of the input file
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+             - inputFilename must be a valid null-terminated string
+*/
+void ProduceMatrixFile(const Graph* g, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN] = {0};
+    int i = 0;
+    
+    // Process filename
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0';
+    strcat(outputFilename, "-MATRIX.TXT");
+    
+    // 2. Open file 
+    FILE* fp = fopen(outputFilename, "w");
+    
+    // Process data
+    if (fp != NULL) {
+
+        int maxNameLen = matrixHelper(g);
+
+        /* Dense graphs: answer every cell from the bit matrix, unless a shared
+           label would leave some of its vertices' columns unset */
+        BitMatrix* m = isDenseGraph(g) ? buildBitMatrix(g) : NULL;
+        if (m != NULL && !m->uniqueLabels) {
+            m = freeBitMatrix(m);
+        }
+
+        /* Sparse graphs: scratch row of neighbor keys, sized for the longest list */
+        int maxRow = 1;
+        for (i = 0; i < g->numVertices; i++) {
+            int rowLen = 0;
+            Node* cur = g->adjList[i].head->edge;
+            while (cur != NULL) {
+                rowLen++;
+                cur = cur->edge;
+            }
+            if (rowLen > maxRow) {
+                maxRow = rowLen;
+            }
+        }
+        LabelKey* rowKeys = malloc(maxRow * sizeof(LabelKey));
+        if (rowKeys == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        
+        /* Print header row */
+        fprintf(fp, "%*s", maxNameLen, "");
+        for (i = 0; i < g->numVertices; i++) {
+            fprintf(fp, "%-*s", maxNameLen, vertexLabel(g, vertexAtInputPos(g, i)));
+        }
+        fprintf(fp, "\n");
+        
+        /* Print matrix rows (rows and columns in input-file order) */
+        for (i = 0; i < g->numVertices; i++) {
+            int row = vertexAtInputPos(g, i);
+            fprintf(fp, "%-*s", maxNameLen, vertexLabel(g, row));
+
+            /* Gather this row's neighbor keys once, contiguously */
+            int rowCount = 0;
+            Node* neighbor = (m == NULL) ? g->adjList[row].head->edge : NULL;
+            while (neighbor != NULL) {
+                rowKeys[rowCount] = g->labels->rank[neighbor->label];
+                rowCount++;
+                neighbor = neighbor->edge;
+            }
+            
+            for (int j = 0; j < g->numVertices; j++) {
+                int col = vertexAtInputPos(g, j);
+                int connected;
+                
+                /* Check connection */
+                if (m != NULL) {
+                    connected = hasEdge(m, row, col);
+                } else {
+                    connected = findLabelKey(rowKeys, rowCount, vertexKey(g, col)) >= 0;
+                }
+                fprintf(fp, "%-*d", maxNameLen, connected);
+            }
+            fprintf(fp, "\n");
+        }
+        m = freeBitMatrix(m);
+        free(rowKeys);
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: Generates a BFS traversal file (<input filename>-BFS.TXT).
+    Returns: void
+    @param  : g             - pointer to the Graph
+    @param  : inputFilename - name of the input file
+    @param  : startVertex   - name of the starting vertex
+
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+             - startVertex must exist in the graph
+             - inputFilename must be a valid null-terminated string
+*/
+void ProduceBFSFile(const Graph* g, const char* inputFilename, const char* startVertex) {
+    char outputFilename[MAX_FILE_NAME_LEN];
+    FILE* fp = NULL;
+    int start = getVertexIndex(g, startVertex);   // -1 if vertex does not exist
+    
+    if (start >= 0) 
+	{
+		// Copy input filename and remove extension
+        strcpy(outputFilename, inputFilename);
+
+		int i;
+        for (i = 0; outputFilename[i] != '\0' && outputFilename[i] != '.'; i++);
+
+        outputFilename[i] = '\0';
+
+        // Append suffix
+        strcat(outputFilename, "-BFS.TXT");
+
+        fp = fopen(outputFilename, "w");
+        if (fp != NULL) 
+		{
+            // stream labels to the file as they are visited
+            TraversalWriter w = { fp, 0 };
+            BFSVisit(g, start, writeVisitor, &w);
+
+            fclose(fp);
+        }
+    }
+}
+
+/**
+    Purpose: Generates a DFS traversal file (<input>-DFS.TXT).
+    Returns: void
+    @param  : g             - pointer to the Graph
+    @param  : inputFilename - name of the input file
+    @param  : startVertex   - name of the starting vertex
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+             - startVertex must exist in the graph
+             - inputFilename must be a valid null-terminated string
+*/
+void ProduceDFSFile(const Graph* g, const char* inputFilename, const char* startVertex) {
+    char outputFilename[MAX_FILE_NAME_LEN];
+    int i = 0;
+    int start = getVertexIndex(g, startVertex);   // -1 if vertex does not exist
+    
+    if (start >= 0) {
+        // Copy input filename and remove extension 
+        strcpy(outputFilename, inputFilename);
+        i = 0;
+        while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+            i++;
+        }
+        outputFilename[i] = '\0'; // Truncate at '.' or end
+        
+        // Append suffix
+        strcat(outputFilename, "-DFS.TXT");
+        
+        FILE* fp = fopen(outputFilename, "w");
+        if (fp != NULL) {
+            // stream labels to the file as they are visited
+            TraversalWriter w = { fp, 0 };
+            DFSVisit(g, start, writeVisitor, &w);
+            fclose(fp);
+        }
+    }
+}
+
+/**
+    Purpose: Counts the common elements of two sorted, duplicate-free int arrays.
+    Returns: |a ∩ b|
+    @param  : a  - first sorted array
+    @param  : na - length of a
+    @param  : b  - second sorted array
+    @param  : nb - length of b
+    Pre-condition:
+             - a and b are strictly increasing.
+    Post-condition:
+             - With SSE2, blocks of four are compared all-against-all (the b block
+               rotated three times), then the block with the smaller maximum is
+               advanced; the tail is a scalar merge.
+*/
+int intersectCount(const int* a, int na, const int* b, int nb) {
+    int i = 0, j = 0, count = 0;
+#ifdef __SSE2__
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128((const __m128i*) (a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*) (b + j));
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        count += popcount64((uint64_t) _mm_movemask_ps(_mm_castsi128_ps(eq)));
+
+        int aMax = a[i + 3];
+        int bMax = b[j + 3];
+        if (aMax <= bMax) {
+            i += 4;
+        }
+        if (bMax <= aMax) {
+            j += 4;
+        }
+    }
+#endif
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (a[i] > b[j]) {
+            j++;
+        } else {
+            count++;
+            i++;
+            j++;
+        }
+    }
+    return count;
+}
+
+/**
+    Purpose: Counts the triangles through every vertex.
+    Returns: void
+    @param  : csr - sorted CSR from buildSortedCSR (undirected graph)
+    @param  : tri - output array; tri[v] = number of triangles containing v
+    Pre-condition:
+             - tri holds csr->numVertices ints.
+    Post-condition:
+             - tri[v] = (1/2) * sum over neighbors u of |N(v) ∩ N(u)|.
+             - Vertices are independent, so they are split across OpenMP threads
+               when available (dynamic schedule, since hub rows cost more).
+*/
+void countTriangles(const GraphCSR* csr, int tri[]) {
+    int n = csr->numVertices;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (int v = 0; v < n; v++) {
+        const int* nv = csr->neighbors + csr->offsets[v];
+        int dv = csr->offsets[v + 1] - csr->offsets[v];
+        long long shared = 0;
+        for (int e = 0; e < dv; e++) {
+            int u = nv[e];
+            shared += intersectCount(nv, dv, csr->neighbors + csr->offsets[u],
+                                     csr->offsets[u + 1] - csr->offsets[u]);
+        }
+        tri[v] = (int) (shared / 2);
+    }
+}
+
+/**
+    Purpose: Generates a triangle / local clustering coefficient report (<input>-TRIANGLES.TXT).
+    Returns: void
+    @param  : g             - pointer to the Graph
+    @param  : inputFilename - name of the input file
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+             - g is an UNDIRECTED graph.
+             - inputFilename must be a valid null-terminated string
+    Post-condition:
+             - One line per vertex, sorted by label: "<label> <triangles> <coefficient>",
+               where coefficient = 2 * triangles / (d * (d - 1)), or 0 when d < 2.
+*/
+void ProduceTrianglesFile(const Graph* g, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int i = 0;
+
+    // Create filename
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0';  // Truncate at '.' or end
+    strcat(outputFilename, "-TRIANGLES.TXT");
+
+    FILE* fp = fopen(outputFilename, "w");
+
+    if (fp != NULL) {
+        int n = g->numVertices;
+        GraphCSR* csr = buildSortedCSR(g);
+        int* tri = malloc((n > 0 ? n : 1) * sizeof(int));
+        KeyIndex* byLabel = malloc((n > 0 ? n : 1) * sizeof(KeyIndex));
+        if (tri == NULL || byLabel == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        countTriangles(csr, tri);
+
+        // Sort vertices by label; shared labels keep input-file order, like DEGREE
+        for (i = 0; i < n; i++) {
+            byLabel[i].key = vertexKey(g, vertexAtInputPos(g, i));
+            byLabel[i].index = i;
+        }
+        qsort(byLabel, n, sizeof(KeyIndex), compareKeyIndex);
+
+        for (i = 0; i < n; i++) {
+            int v = vertexAtInputPos(g, byLabel[i].index);
+            int d = csr->offsets[v + 1] - csr->offsets[v];
+            double coefficient = 0.0;
+            if (d >= 2) {
+                coefficient = 2.0 * tri[v] / ((double) d * (d - 1));
+            }
+            fprintf(fp, "%s %d %.4f\n", vertexLabel(g, v), tri[v], coefficient);
+        }
+
+        free(tri);
+        free(byLabel);
+        csr = freeCSR(csr);
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: Builds the transpose of a CSR (edge u->v becomes v->u).
+    Returns: Pointer to the new GraphCSR
+    @param  : csr - CSR to transpose
+    Pre-condition:
+             - csr must not be NULL.
+    Post-condition:
+             - Row v of the result lists every u whose row contains v, in
+               ascending u order. Built with one counting pass, O(V + E).
+             - Program exits on malloc failure.
+*/
+GraphCSR* transposeCSR(const GraphCSR* csr) {
+    int n = csr->numVertices;
+    GraphCSR* t = malloc(sizeof(GraphCSR));
+    if (t == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    t->numVertices = n;
+    t->numEdges = csr->numEdges;
+    t->offsets = calloc(n + 1, sizeof(int));
+    t->neighbors = malloc((csr->numEdges > 0 ? csr->numEdges : 1) * sizeof(int));
+    int* fill = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (t->offsets == NULL || t->neighbors == NULL || fill == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    int e, v;
+    for (e = 0; e < csr->numEdges; e++) {
+        t->offsets[csr->neighbors[e] + 1]++;
+    }
+    for (v = 0; v < n; v++) {
+        t->offsets[v + 1] += t->offsets[v];
+        fill[v] = t->offsets[v];
+    }
+    for (int u = 0; u < n; u++) {
+        for (e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int dst = csr->neighbors[e];
+            t->neighbors[fill[dst]] = u;
+            fill[dst]++;
+        }
+    }
+    free(fill);
+    return t;
+}
+
+/**
+    Purpose: Fills PageRankParams with the usual defaults.
+    Returns: void
+    @param  : p - pointer to the parameters to reset
+    Post-condition:
+             - damping 0.85, tolerance 1e-9 (L1 change per sweep), at most 100 sweeps.
+*/
+void initPageRankParams(PageRankParams* p) {
+    p->damping = 0.85;
+    p->tolerance = 1e-9;
+    p->maxIterations = 100;
+}
+
+/**
+    Purpose: Computes PageRank by pull-based power iteration.
+    Returns: Number of sweeps performed
+    @param  : csr    - index form of the graph (row u = out-neighbors of u)
+    @param  : params - damping, tolerance and iteration cap (NULL = defaults)
+    @param  : rank   - output array of csr->numVertices scores summing to 1
+    Pre-condition:
+             - csr must not be NULL; rank holds csr->numVertices doubles.
+    Post-condition:
+             - Each sweep first writes contrib[u] = rank[u] / outdeg(u) into one
+               contiguous array, then every vertex sums contrib over its
+               in-neighbor row (the transposed CSR). Writes go only to the
+               vertex's own slot, so the sweep runs across OpenMP threads
+               without locks.
+             - Rank held by vertices with no out-edges is spread evenly.
+             - Stops when the L1 change drops below the tolerance or the cap is hit.
+*/
+int computePageRank(const GraphCSR* csr, const PageRankParams* params, double rank[]) {
+    PageRankParams defaults;
+    if (params == NULL) {
+        initPageRankParams(&defaults);
+        params = &defaults;
+    }
+    int n = csr->numVertices;
+    if (n == 0) {
+        return 0;
+    }
+
+    GraphCSR* in = transposeCSR(csr);
+    double* contrib = malloc(n * sizeof(double));
+    double* next = malloc(n * sizeof(double));
+    if (contrib == NULL || next == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    int v;
+    for (v = 0; v < n; v++) {
+        rank[v] = 1.0 / n;
+    }
+
+    int iter = 0;
+    double diff = params->tolerance + 1.0;
+    while (iter < params->maxIterations && diff >= params->tolerance) {
+        double dangling = 0.0;
+#ifdef _OPENMP
+        #pragma omp parallel for reduction(+:dangling)
+#endif
+        for (v = 0; v < n; v++) {
+            int outDeg = csr->offsets[v + 1] - csr->offsets[v];
+            if (outDeg > 0) {
+                contrib[v] = rank[v] / outDeg;
+            } else {
+                contrib[v] = 0.0;
+                dangling += rank[v];
+            }
+        }
+
+        double base = (1.0 - params->damping) / n + params->damping * dangling / n;
+        diff = 0.0;
+#ifdef _OPENMP
+        #pragma omp parallel for reduction(+:diff) schedule(dynamic, 256)
+#endif
+        for (v = 0; v < n; v++) {
+            double sum = 0.0;
+            for (int e = in->offsets[v]; e < in->offsets[v + 1]; e++) {
+                sum += contrib[in->neighbors[e]];
+            }
+            next[v] = base + params->damping * sum;
+            diff += fabs(next[v] - rank[v]);
+        }
+        memcpy(rank, next, n * sizeof(double));
+        iter++;
+    }
+
+    free(contrib);
+    free(next);
+    in = freeCSR(in);
+    return iter;
+}
+
+/**
+    Purpose: Rounds a non-negative score to a fixed number of decimals, in floating point.
+    Returns: score * scale rounded to the nearest integer, as a double
+    @param  : score - value to round
+    @param  : scale - 10^decimals, e.g. 1e4 for "%.4f"
+    Post-condition:
+             - Scaled values of 2^52 and up are already integers and are returned
+               as is, so the conversion below cannot overflow for any score.
+             - Needs no libm.
+*/
+double roundScore(double score, double scale) {
+    double scaled = score * scale;
+    if (scaled < 4503599627370496.0) {   // 2^52
+        scaled = (double) (long long) (scaled + 0.5);
+    }
+    return scaled;
+}
+
+/**
+    Purpose: Orders two VertexScore entries by descending rounded score, then by label.
+    Returns: <0, 0 or >0
+    @param  : x     - first entry
+    @param  : y     - second entry
+    @param  : scale - 10^decimals the scores are printed with
+    Post-condition:
+             - Scores that print the same compare equal, so rounding noise from
+               another summation order (e.g. after ReorderGraph) cannot reorder them.
+*/
+int compareScoresAt(const VertexScore* x, const VertexScore* y, double scale) {
+    double sx = roundScore(x->score, scale);
+    double sy = roundScore(y->score, scale);
+    if (sx != sy) {
+        return (sx < sy) ? 1 : -1;
+    }
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+/**
+    Purpose: qsort comparator for the RANK report (scores printed with 6 decimals).
+    Returns: <0, 0 or >0
+    @param  : a - pointer to the first VertexScore
+    @param  : b - pointer to the second VertexScore
+*/
+int compareRankScore(const void* a, const void* b) {
+    return compareScoresAt(a, b, 1e6);
+}
+
+/**
+    Purpose: qsort comparator for the BETWEENNESS report (scores printed with 4 decimals).
+    Returns: <0, 0 or >0
+    @param  : a - pointer to the first VertexScore
+    @param  : b - pointer to the second VertexScore
+*/
+int compareBetweennessScore(const void* a, const void* b) {
+    return compareScoresAt(a, b, 1e4);
+}
+
+/**
+    Purpose: Generates a PageRank report (<input>-RANK.TXT).
+    Returns: void
+    @param  : g             - pointer to the Graph
+    @param  : inputFilename - name of the input file
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+             - inputFilename must be a valid null-terminated string
+    Post-condition:
+             - One line per vertex, highest rank first (ties by label): "<label> <rank>".
+*/
+void ProduceRankFile(const Graph* g, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int i = 0;
+
+    // Create filename
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0';  // Truncate at '.' or end
+    strcat(outputFilename, "-RANK.TXT");
+
+    FILE* fp = fopen(outputFilename, "w");
+
+    if (fp != NULL) {
+        int n = g->numVertices;
+        GraphCSR* csr = buildSortedCSR(g);
+        double* rank = malloc((n > 0 ? n : 1) * sizeof(double));
+        VertexScore* scores = malloc((n > 0 ? n : 1) * sizeof(VertexScore));
+        if (rank == NULL || scores == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        computePageRank(csr, NULL, rank);
+
+        // Sort by rank
+        for (i = 0; i < n; i++) {
+            scores[i].index = i;
+            scores[i].key = vertexKey(g, i);
+            scores[i].score = rank[i];
+        }
+        qsort(scores, n, sizeof(VertexScore), compareRankScore);
+
+        for (i = 0; i < n; i++) {
+            fprintf(fp, "%s %.6f\n", vertexLabel(g, scores[i].index), scores[i].score);
+        }
+
+        free(rank);
+        free(scores);
+        csr = freeCSR(csr);
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: Allocates the per-source scratch arrays used by Brandes' algorithm.
+    Returns: void
+    @param  : ws - workspace to initialize
+    @param  : n  - number of vertices
+    Post-condition:
+             - All arrays hold n entries. Program exits on malloc failure.
+*/
+void initBrandesWorkspace(BrandesWorkspace* ws, int n) {
+    int size = n > 0 ? n : 1;
+    ws->dist = malloc(size * sizeof(int));
+    ws->order = malloc(size * sizeof(int));
+    ws->sigma = malloc(size * sizeof(double));
+    ws->delta = malloc(size * sizeof(double));
+    if (ws->dist == NULL || ws->order == NULL || ws->sigma == NULL || ws->delta == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (int v = 0; v < n; v++) {
+        ws->dist[v] = -1;
+    }
+}
+
+/**
+    Purpose: Frees the arrays of a BrandesWorkspace.
+    Returns: void
+    @param  : ws - workspace to release
+*/
+void freeBrandesWorkspace(BrandesWorkspace* ws) {
+    free(ws->dist);
+    free(ws->order);
+    free(ws->sigma);
+    free(ws->delta);
+}
+
+/**
+    Purpose: Adds one source's dependencies to the betweenness scores (one Brandes step).
+    Returns: void
+    @param  : csr - index form of the graph
+    @param  : s   - source vertex
+    @param  : ws  - scratch arrays; dist[] must be all -1 on entry
+    @param  : bc  - accumulator the dependencies are added to
+    Post-condition:
+             - A BFS from s records shortest-path counts (sigma) and the visit
+               order; walking that order backwards accumulates
+               delta[v] = sum over successors w of sigma[v]/sigma[w] * (1 + delta[w]).
+             - Only vertices reached from s are touched, and dist[] is reset to
+               -1 for exactly those, so the workspace is reusable at O(reached) cost.
+*/
+void brandesAccumulate(const GraphCSR* csr, int s, BrandesWorkspace* ws, double bc[]) {
+    int front = 0, rear = 0;
+
+    ws->dist[s] = 0;
+    ws->sigma[s] = 1.0;
+    ws->delta[s] = 0.0;
+    ws->order[rear] = s;
+    rear++;
+
+    // forward BFS; order[] doubles as the queue and the visit stack
+    while (front < rear) {
+        int v = ws->order[front];
+        front++;
+        for (int e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+            int w = csr->neighbors[e];
+            if (ws->dist[w] < 0) {
+                ws->dist[w] = ws->dist[v] + 1;
+                ws->sigma[w] = 0.0;
+                ws->delta[w] = 0.0;
+                ws->order[rear] = w;
+                rear++;
+            }
+            if (ws->dist[w] == ws->dist[v] + 1) {
+                ws->sigma[w] += ws->sigma[v];
+            }
+        }
+    }
+
+    // dependency accumulation in reverse BFS order
+    for (int k = rear - 1; k >= 0; k--) {
+        int w = ws->order[k];
+        for (int e = csr->offsets[w]; e < csr->offsets[w + 1]; e++) {
+            int v = csr->neighbors[e];
+            if (ws->dist[v] == ws->dist[w] - 1) {
+                ws->delta[v] += ws->sigma[v] / ws->sigma[w] * (1.0 + ws->delta[w]);
+            }
+        }
+        if (w != s) {
+            bc[w] += ws->delta[w];
+        }
+    }
+
+    for (int k = 0; k < rear; k++) {
+        ws->dist[ws->order[k]] = -1;
+    }
+}
+
+/**
+    Purpose: Computes betweenness centrality, exactly or from a sample of sources.
+    Returns: Number of sources processed
+    @param  : csr     - sorted index form of an UNDIRECTED graph
+    @param  : samples - 0 (or >= V) for exact Brandes; otherwise number of sampled sources
+    @param  : seed    - seed for choosing the sampled sources
+    @param  : bc      - output array of csr->numVertices scores
+    Pre-condition:
+             - bc holds csr->numVertices doubles.
+    Post-condition:
+             - bc[v] is the number of shortest paths between other pairs that pass
+               through v (each unordered pair counted once).
+             - Sampled mode scales by V / samples, giving an unbiased estimate.
+             - Sources are spread over OpenMP threads; each thread owns a workspace and
+               a private accumulator, merged once at the end.
+*/
+int computeBetweenness(const GraphCSR* csr, int samples, unsigned int seed, double bc[]) {
+    int n = csr->numVertices;
+    int* sources = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (sources == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int v;
+    for (v = 0; v < n; v++) {
+        sources[v] = v;
+        bc[v] = 0.0;
+    }
+
+    // partial Fisher-Yates shuffle picks the sampled sources
+    int numSources = n;
+    if (samples > 0 && samples < n) {
+        unsigned int state = seed ? seed : 1u;
+        for (int k = 0; k < samples; k++) {
+            state = state * 1103515245u + 12345u;
+            int pick = k + (int) ((state >> 8) % (unsigned int) (n - k));
+            int temp = sources[k];
+            sources[k] = sources[pick];
+            sources[pick] = temp;
+        }
+        numSources = samples;
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        BrandesWorkspace ws;
+        double* local = calloc(n > 0 ? n : 1, sizeof(double));
+        if (local == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        initBrandesWorkspace(&ws, n);
+
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+#endif
+        for (int k = 0; k < numSources; k++) {
+            brandesAccumulate(csr, sources[k], &ws, local);
+        }
+
+#ifdef _OPENMP
+        #pragma omp critical
+#endif
+        for (int u = 0; u < n; u++) {
+            bc[u] += local[u];
+        }
+        freeBrandesWorkspace(&ws);
+        free(local);
+    }
+
+    // each unordered pair was seen from both endpoints; rescale samples
+    double scale = 0.5 * ((double) n / (numSources > 0 ? numSources : 1));
+    for (v = 0; v < n; v++) {
+        bc[v] *= scale;
+    }
+
+    free(sources);
+    return numSources;
+}
+
+/**
+    Purpose: Generates a betweenness centrality report (<input>-BETWEENNESS.TXT).
+    Returns: void
+    @param  : g             - pointer to the Graph
+    @param  : inputFilename - name of the input file
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+             - g is an UNDIRECTED graph.
+             - inputFilename must be a valid null-terminated string
+    Post-condition:
+             - One line per vertex, highest score first (ties by label): "<label> <score>".
+             - Exact for graphs up to BETWEENNESS_EXACT_MAX vertices, otherwise
+               estimated from BETWEENNESS_SAMPLES sources.
+*/
+void ProduceBetweennessFile(const Graph* g, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int i = 0;
+
+    // Create filename
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0';  // Truncate at '.' or end
+    strcat(outputFilename, "-BETWEENNESS.TXT");
+
+    FILE* fp = fopen(outputFilename, "w");
+
+    if (fp != NULL) {
+        int n = g->numVertices;
+        GraphCSR* csr = buildSortedCSR(g);
+        double* bc = malloc((n > 0 ? n : 1) * sizeof(double));
+        VertexScore* scores = malloc((n > 0 ? n : 1) * sizeof(VertexScore));
+        if (bc == NULL || scores == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        int samples = (n <= BETWEENNESS_EXACT_MAX) ? 0 : BETWEENNESS_SAMPLES;
+        computeBetweenness(csr, samples, 1u, bc);
+
+        // Sort by score
+        for (i = 0; i < n; i++) {
+            scores[i].index = i;
+            scores[i].key = vertexKey(g, i);
+            scores[i].score = bc[i];
+        }
+        qsort(scores, n, sizeof(VertexScore), compareBetweennessScore);
+
+        for (i = 0; i < n; i++) {
+            fprintf(fp, "%s %.4f\n", vertexLabel(g, scores[i].index), scores[i].score);
+        }
+
+        free(bc);
+        free(scores);
+        csr = freeCSR(csr);
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: Allocates a BFS workspace that can be reused across many runs.
+    Returns: void
+    @param  : ws - workspace to initialize
+    @param  : n  - number of vertices
+    Post-condition:
+             - dist[] is all -1 and no vertices are marked reached.
+             - Program exits on malloc failure.
+*/
+void initBFSWorkspace(BFSWorkspace* ws, int n) {
+    int size = n > 0 ? n : 1;
+    ws->dist = malloc(size * sizeof(int));
+    ws->queue = malloc(size * sizeof(int));
+    if (ws->dist == NULL || ws->queue == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (int v = 0; v < n; v++) {
+        ws->dist[v] = -1;
+    }
+    ws->reached = 0;
+}
+
+/**
+    Purpose: Frees the arrays of a BFSWorkspace.
+    Returns: void
+    @param  : ws - workspace to release
+*/
+void freeBFSWorkspace(BFSWorkspace* ws) {
+    free(ws->dist);
+    free(ws->queue);
+}
+
+/**
+    Purpose: Computes hop distances from one source, reusing a workspace.
+    Returns: Eccentricity of s (largest distance to a vertex it reaches)
+    @param  : csr - index form of the graph
+    @param  : s   - source vertex
+    @param  : ws  - workspace from initBFSWorkspace
+    Post-condition:
+             - ws->dist[v] is the distance from s, or -1 if unreached.
+             - ws->queue[0 .. ws->reached-1] lists the reached vertices in BFS order.
+             - Only the previous run's reached vertices are cleared first, so a
+               run costs O(reached vertices + their edges), not O(V).
+*/
+int bfsDistances(const GraphCSR* csr, int s, BFSWorkspace* ws) {
+    int k;
+    for (k = 0; k < ws->reached; k++) {
+        ws->dist[ws->queue[k]] = -1;
+    }
+
+    int front = 0, rear = 0;
+    ws->dist[s] = 0;
+    ws->queue[rear] = s;
+    rear++;
+    while (front < rear) {
+        int v = ws->queue[front];
+        front++;
+        for (int e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+            int w = csr->neighbors[e];
+            if (ws->dist[w] < 0) {
+                ws->dist[w] = ws->dist[v] + 1;
+                ws->queue[rear] = w;
+                rear++;
+            }
+        }
+    }
+    ws->reached = rear;
+    return ws->dist[ws->queue[rear - 1]];
+}
+
+/**
+    Purpose: Computes exact diameter and radius of one connected component with eccentricity bounds.
+    Returns: Number of BFS runs used
+    @param  : csr    - sorted index form of an UNDIRECTED graph
+    @param  : start  - any vertex of the component
+    @param  : ws     - reusable BFS workspace
+    @param  : lower  - scratch, eccentricity lower bounds (numVertices ints)
+    @param  : upper  - scratch, eccentricity upper bounds (numVertices ints)
+    @param  : ecc    - receives the exact eccentricity of every vertex BFS was run from
+    @param  : result - receives the component's diameter, radius and size
+    Post-condition:
+             - Each BFS from v tightens every w's bounds to
+               max(d, ecc(v) - d) <= ecc(w) <= ecc(v) + d, where d = dist(v, w).
+             - Vertices whose bounds cannot change the answer are dropped; the
+               next source alternates between the largest upper bound and the
+               smallest lower bound (the fringe of the current estimate).
+             - Stops once both diameter and radius bounds meet, which on real
+               graphs usually takes a handful of BFS runs.
+*/
+int componentDiameter(const GraphCSR* csr, int start, BFSWorkspace* ws,
+                      int lower[], int upper[], int ecc[], DiameterResult* result) {
+    // collect the component (the first BFS doubles as a bound update)
+    int e0 = bfsDistances(csr, start, ws);
+    int size = ws->reached;
+    int* members = malloc(size * sizeof(int));
+    if (members == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    memcpy(members, ws->queue, size * sizeof(int));
+
+    int k, v = start, e = e0;
+    int runs = 1;
+    int dLow = 0, rUp = size;    // size bounds any eccentricity
+    int dUp = size, rLow = 0;
+    int remaining = size;        // candidates are members[0 .. remaining-1]
+    int pickHigh = 1;
+    for (k = 0; k < size; k++) {
+        lower[members[k]] = 0;
+        upper[members[k]] = size;
+    }
+
+    while (1) {
+        ecc[v] = e;
+        if (e > dLow) {
+            dLow = e;
+        }
+        if (e < rUp) {
+            rUp = e;
+        }
+
+        // tighten bounds and drop candidates that no longer matter
+        dUp = dLow;
+        rLow = rUp;
+        for (k = 0; k < remaining; k++) {
+            int w = members[k];
+            int d = ws->dist[w];
+            int lo = (e - d > d) ? e - d : d;
+            if (lo > lower[w]) {
+                lower[w] = lo;
+            }
+            if (e + d < upper[w]) {
+                upper[w] = e + d;
+            }
+            if (lower[w] == upper[w] || (upper[w] <= dLow && lower[w] >= rUp)) {
+                members[k] = members[remaining - 1];
+                members[remaining - 1] = w;
+                remaining--;
+                k--;
+            } else {
+                if (upper[w] > dUp) {
+                    dUp = upper[w];
+                }
+                if (lower[w] < rLow) {
+                    rLow = lower[w];
+                }
+            }
+        }
+
+        if ((dLow == dUp && rLow == rUp) || remaining == 0) {
+            break;
+        }
+
+        // next source: alternate between the two ends of the fringe
+        int best = members[0];
+        for (k = 1; k < remaining; k++) {
+            int w = members[k];
+            if (pickHigh ? upper[w] > upper[best] : lower[w] < lower[best]) {
+                best = w;
+            }
+        }
+        pickHigh = !pickHigh;
+        v = best;
+        e = bfsDistances(csr, v, ws);
+        runs++;
+    }
+
+    result->diameter = dLow;
+    result->radius = rUp;
+    result->size = size;
+    free(members);
+    return runs;
+}
+
+/**
+    Purpose: Computes the diameter and radius of a graph, per connected component.
+    Returns: Total number of BFS runs used
+    @param  : csr    - sorted index form of an UNDIRECTED graph
+    @param  : exact  - nonzero to run BFS from every vertex (all eccentricities exact)
+    @param  : ecc    - output; ecc[v] = eccentricity within v's component, or -1
+                       if bounding never needed a BFS from v
+    @param  : result - receives diameter (largest over components), and radius
+                       and size of the largest component
+    Pre-condition:
+             - ecc holds csr->numVertices ints.
+    Post-condition:
+             - One BFS workspace is shared by every run.
+*/
+int computeDiameter(const GraphCSR* csr, int exact, int ecc[], DiameterResult* result) {
+    int n = csr->numVertices;
+    int runs = 0;
+    BFSWorkspace ws;
+    initBFSWorkspace(&ws, n);
+    int* component = malloc((n > 0 ? n : 1) * sizeof(int));
+    int* lower = malloc((n > 0 ? n : 1) * sizeof(int));
+    int* upper = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (component == NULL || lower == NULL || upper == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    int v, k;
+    for (v = 0; v < n; v++) {
+        component[v] = -1;
+        ecc[v] = -1;
+    }
+    result->diameter = 0;
+    result->radius = 0;
+    result->size = 0;
+
+    for (v = 0; v < n; v++) {
+        if (component[v] < 0) {
+            DiameterResult part;
+            if (exact) {
+                // BFS from every member of this component
+                bfsDistances(csr, v, &ws);
+                int size = ws.reached;
+                int* members = malloc(size * sizeof(int));
+                if (members == NULL) {
+                    fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                    exit(1);
+                }
+                memcpy(members, ws.queue, size * sizeof(int));
+                part.diameter = 0;
+                part.radius = size;
+                part.size = size;
+                for (k = 0; k < size; k++) {
+                    int e = bfsDistances(csr, members[k], &ws);
+                    ecc[members[k]] = e;
+                    if (e > part.diameter) {
+                        part.diameter = e;
+                    }
+                    if (e < part.radius) {
+                        part.radius = e;
+                    }
+                }
+                runs += size + 1;
+                free(members);
+            } else {
+                runs += componentDiameter(csr, v, &ws, lower, upper, ecc, &part);
+            }
+
+            // every run stayed inside this component, so the last queue lists it
+            for (k = 0; k < ws.reached; k++) {
+                component[ws.queue[k]] = v;
+            }
+            if (part.diameter > result->diameter) {
+                result->diameter = part.diameter;
+            }
+            if (part.size > result->size) {
+                result->size = part.size;
+                result->radius = part.radius;
+            }
+        }
+    }
+
+    free(component);
+    free(lower);
+    free(upper);
+    freeBFSWorkspace(&ws);
+    return runs;
+}
+
+/**
+    Purpose: Generates an eccentricity / diameter / radius report (<input>-ECC.TXT).
+    Returns: void
+    @param  : g             - pointer to the Graph
+    @param  : inputFilename - name of the input file
+    Pre-condition:
+             - g must not be NULL and must contain valid graph data
+             - g is an UNDIRECTED graph.
+             - inputFilename must be a valid null-terminated string
+    Post-condition:
+             - First line "Diameter: d" (largest over all components), second line
+               "Radius: r" (of the largest component).
+             - Graphs up to ECCENTRICITY_EXACT_MAX vertices then list every vertex's
+               eccentricity by label; larger graphs only get the two summary lines,
+               computed with the bounding algorithm.
+*/
+void ProduceEccentricityFile(const Graph* g, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int i = 0;
+
+    // Create filename
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0';  // Truncate at '.' or end
+    strcat(outputFilename, "-ECC.TXT");
+
+    FILE* fp = fopen(outputFilename, "w");
+
+    if (fp != NULL) {
+        int n = g->numVertices;
+        int exact = (n <= ECCENTRICITY_EXACT_MAX);
+        GraphCSR* csr = buildSortedCSR(g);
+        int* ecc = malloc((n > 0 ? n : 1) * sizeof(int));
+        if (ecc == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        DiameterResult result;
+        computeDiameter(csr, exact, ecc, &result);
+
+        fprintf(fp, "Diameter: %d\n", result.diameter);
+        fprintf(fp, "Radius: %d\n", result.radius);
+
+        if (exact) {
+            // Per-vertex eccentricities, sorted by label
+            KeyIndex* byLabel = malloc((n > 0 ? n : 1) * sizeof(KeyIndex));
+            if (byLabel == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+            for (i = 0; i < n; i++) {
+                byLabel[i].key = vertexKey(g, vertexAtInputPos(g, i));
+                byLabel[i].index = i;   // input position, so shared labels keep file order
+            }
+            qsort(byLabel, n, sizeof(KeyIndex), compareKeyIndex);
+            for (i = 0; i < n; i++) {
+                int v = vertexAtInputPos(g, byLabel[i].index);
+                fprintf(fp, "%s %d\n", vertexLabel(g, v), ecc[v]);
+            }
+            free(byLabel);
+        }
+
+        free(ecc);
+        csr = freeCSR(csr);
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: Maps a signed delta to an unsigned code (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...).
+    Returns: The zigzag code
+    @param  : delta - signed value to encode
+*/
+unsigned int zigzagEncode(int delta) {
+    return (delta >= 0) ? (unsigned int) delta * 2 : (unsigned int) (-(delta + 1)) * 2 + 1;
+}
+
+/**
+    Purpose: Inverse of zigzagEncode.
+    Returns: The signed delta
+    @param  : code - zigzag code
+*/
+int zigzagDecode(unsigned int code) {
+    return (code & 1) ? -(int) (code >> 1) - 1 : (int) (code >> 1);
+}
+
+/**
+    Purpose: Appends an unsigned LEB128 varint (7 bits per byte, high bit = more).
+    Returns: Number of bytes written (1..5)
+    @param  : out   - destination buffer with room for 5 bytes
+    @param  : value - value to encode
+*/
+int writeVarint(unsigned char* out, unsigned int value) {
+    int n = 0;
+    while (value >= 0x80) {
+        out[n] = (unsigned char) (value | 0x80);
+        value >>= 7;
+        n++;
+    }
+    out[n] = (unsigned char) value;
+    return n + 1;
+}
+
+/**
+    Purpose: Decodes one varint and advances the read pointer.
+    Returns: The decoded value
+    @param  : p - address of the read pointer
+    Post-condition:
+             - Single-byte values (the common case for small gaps) take the fast path.
+*/
+unsigned int readVarint(const unsigned char** p) {
+    const unsigned char* q = *p;
+    unsigned int value = q[0];
+    if (value < 0x80) {
+        *p = q + 1;
+        return value;
+    }
+    value &= 0x7F;
+    int shift = 7;
+    q++;
+    while (*q & 0x80) {
+        value |= (unsigned int) (*q & 0x7F) << shift;
+        shift += 7;
+        q++;
+    }
+    value |= (unsigned int) *q << shift;
+    *p = q + 1;
+    return value;
+}
+
+/**
+    Purpose: Encodes one vertex's neighbor block.
+    Returns: Number of bytes written
+    @param  : out   - destination with room for (count + 1) * 5 bytes
+    @param  : v     - the vertex the block belongs to
+    @param  : nb    - strictly increasing neighbor indices
+    @param  : count - number of neighbors
+    Post-condition:
+             - Varint count, then the first neighbor as a zigzag delta from v,
+               then each following neighbor as (gap - 1).
+*/
+size_t encodeNeighborBlock(unsigned char* out, int v, const int nb[], int count) {
+    size_t len = writeVarint(out, (unsigned int) count);
+    for (int e = 0; e < count; e++) {
+        unsigned int code = (e == 0) ? zigzagEncode(nb[e] - v) : (unsigned int) (nb[e] - nb[e - 1] - 1);
+        len += writeVarint(out + len, code);
+    }
+    return len;
+}
+
+/**
+    Purpose: Records where a vertex's block starts.
+    Returns: void
+    @param  : cg  - pointer to the CompressedGraph being filled
+    @param  : v   - vertex index (numVertices for the end of the data)
+    @param  : pos - byte offset of the block in cg->data
+    Pre-condition:
+             - Blocks are placed in index order, so pos never decreases.
+*/
+void setBlockOffset(CompressedGraph* cg, int v, size_t pos) {
+    if (v % COMPRESSED_GROUP == 0) {
+        cg->groupBase[v / COMPRESSED_GROUP] = pos;
+    }
+    cg->offsets[v] = (uint32_t) (pos - cg->groupBase[v / COMPRESSED_GROUP]);
+}
+
+/**
+    Purpose: Encodes a sorted CSR as per-vertex delta + varint neighbor blocks.
+    Returns: Pointer to the new CompressedGraph
+    @param  : csr - sorted, duplicate-free CSR (see buildSortedCSR)
+    Pre-condition:
+             - Every row of csr is strictly increasing.
+    Post-condition:
+             - Block of v: varint degree, then the first neighbor as a zigzag
+               delta from v, then each following neighbor as (gap - 1).
+             - The offset index costs 4 bytes per vertex: a 32-bit offset relative
+               to a 64-bit base stored once per COMPRESSED_GROUP vertices.
+             - Program exits on malloc failure.
+*/
+CompressedGraph* compressCSR(const GraphCSR* csr) {
+    int n = csr->numVertices;
+    CompressedGraph* cg = malloc(sizeof(CompressedGraph));
+    if (cg == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    cg->numVertices = n;
+    cg->numEdges = csr->numEdges;
+    cg->offsets = malloc((n + 1) * sizeof(uint32_t));
+    cg->groupBase = malloc((n / COMPRESSED_GROUP + 1) * sizeof(size_t));
+
+    // worst case is 5 bytes per varint; shrink once the real size is known
+    size_t cap = ((size_t) n + csr->numEdges) * 5 + 1;
+    cg->data = malloc(cap);
+    if (cg->offsets == NULL || cg->groupBase == NULL || cg->data == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    size_t pos = 0;
+    for (int v = 0; v < n; v++) {
+        int begin = csr->offsets[v];
+        setBlockOffset(cg, v, pos);
+        pos += encodeNeighborBlock(cg->data + pos, v, csr->neighbors + begin, csr->offsets[v + 1] - begin);
+    }
+    setBlockOffset(cg, n, pos);
+    cg->dataSize = pos;
+
+    unsigned char* shrunk = realloc(cg->data, pos > 0 ? pos : 1);
+    if (shrunk != NULL) {
+        cg->data = shrunk;
+    }
+    return cg;
+}
+
+/**
+    Purpose: Compresses a graph with its vertices renumbered in label order.
+    Returns: Pointer to the new CompressedGraph
+    @param  : g          - pointer to the Graph
+    @param  : labelOrder - output; labelOrder[i] is the vertex numbered i in the compressed form
+    Pre-condition:
+             - The label index is built (see buildLabelIndex).
+             - labelOrder holds g->numVertices ints.
+    Post-condition:
+             - Ascending index order is ascending label order, so compressedBFS and
+               compressedDFS visit neighbors in the same order as BFSVisit and
+               DFSVisit. Repeats, self-loops and labels that are not a vertex are
+               dropped; a traversal skips them anyway.
+             - Vertices sharing a label may be numbered in either order; neighbors
+               always name the one nodeVertex picks, so traversals are unaffected.
+             - Program exits on malloc failure.
+*/
+CompressedGraph* compressGraphByLabel(const Graph* g, int labelOrder[]) {
+    int n = g->numVertices;
+    KeyIndex* keys = malloc((n > 0 ? n : 1) * sizeof(KeyIndex));
+    int* id = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (keys == NULL || id == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (int v = 0; v < n; v++) {
+        keys[v].key = vertexKey(g, v);
+        keys[v].index = v;
+    }
+    qsort(keys, n, sizeof(KeyIndex), compareKeyIndex);
+    for (int i = 0; i < n; i++) {
+        labelOrder[i] = keys[i].index;
+        id[keys[i].index] = i;
+    }
+
+    // rows in label order, each sorted and compacted like buildSortedCSR
+    GraphCSR* csr = buildCSR(g);
+    GraphCSR byLabel;
+    byLabel.numVertices = n;
+    byLabel.offsets = malloc((n + 1) * sizeof(int));
+    byLabel.neighbors = malloc((csr->numEdges > 0 ? csr->numEdges : 1) * sizeof(int));
+    if (byLabel.offsets == NULL || byLabel.neighbors == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        int v = labelOrder[i];
+        int begin = k;
+        for (int e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+            byLabel.neighbors[k] = id[csr->neighbors[e]];
+            k++;
+        }
+        qsort(byLabel.neighbors + begin, k - begin, sizeof(int), compareInt);
+
+        int end = k;
+        k = begin;
+        byLabel.offsets[i] = begin;
+        for (int e = begin; e < end; e++) {
+            int u = byLabel.neighbors[e];
+            if (u != i && (k == begin || byLabel.neighbors[k - 1] != u)) {
+                byLabel.neighbors[k] = u;
+                k++;
+            }
+        }
+    }
+    byLabel.offsets[n] = k;
+    byLabel.numEdges = k;
+
+    CompressedGraph* cg = compressCSR(&byLabel);
+    free(byLabel.offsets);
+    free(byLabel.neighbors);
+    csr = freeCSR(csr);
+    free(keys);
+    free(id);
+    return cg;
+}
+
+/**
+    Purpose: Frees a CompressedGraph.
+    Returns: NULL
+    @param  : cg - pointer to the CompressedGraph to free
+    Post-condition:
+             - Returns NULL so caller can safely do: cg = freeCompressedGraph(cg);
+*/
+CompressedGraph* freeCompressedGraph(CompressedGraph* cg) {
+    if (cg != NULL) {
+        free(cg->offsets);
+        free(cg->groupBase);
+        free(cg->data);
+        free(cg);
+    }
+    return NULL;
+}
+
+/**
+    Purpose: Reads a graph file straight into compressed form, without building adjacency lists.
+    Returns: 1 if successful; 0 if the file cannot be opened; -1 if it is malformed
+             (no vertex count in the header, or fewer records than declared).
+    @param  : strInputFileName - name of the input file containing graph data
+    @param  : CDS              - address of a CompressedInput* to populate
+    Pre-condition:
+             - strInputFileName must be a valid, null-terminated string.
+             - CDS must be non-NULL.
+    Post-condition:
+             - Vertices are numbered in label order, input order among equal labels,
+               and the blocks hold the rows compressGraphByLabel would build.
+             - Two passes over the file: the first interns the vertex labels, the
+               second encodes one line at a time into a scratch buffer in input
+               order, which is then copied into label order. No Node is allocated;
+               peak memory is the labels, O(V) ints and twice the encoded rows.
+             - Labels that are not a vertex are counted in listDegree but never stored.
+             - On failure, *CDS is left unmodified.
+             - Program exits on malloc failure.
+*/
+int ReadCompressedInputFile(strFile strInputFileName, CompressedInput** CDS) {
+    FILE* fp = fopen(strInputFileName, "r");
+    if (fp == NULL) {
+        return 0;
+    }
+    int n = 0;
+    if (fscanf(fp, "%d", &n) != 1 || n < 0) {
+        fclose(fp);
+        return -1;
+    }
+
+    LabelArena* labels = createLabelArena(n);
+    int* lineLabel = malloc((n > 0 ? n : 1) * sizeof(int));   // input line -> label id
+    int* id = malloc((n > 0 ? n : 1) * sizeof(int));          // input line -> vertex
+    size_t tokenCap = 64;
+    char* token = malloc(tokenCap);
+    if (lineLabel == NULL || id == NULL || token == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    // 1) First pass: vertex labels only
+    long long recordsStart = graphTell(fp);
+    int i, len, ok = 1;
+    for (i = 0; i < n && ok; i++) {
+        len = readToken(fp, &token, &tokenCap);
+        ok = (len >= 0);
+        if (ok) {
+            lineLabel[i] = internLabel(labels, token, len);
+        }
+        while (ok && readToken(fp, &token, &tokenCap) >= 0 && strcmp(token, "-1") != 0) {
+            // skip neighbors
+        }
+    }
+    if (!ok) {
+        freeLabelArena(labels);
+        free(lineLabel);
+        free(id);
+        free(token);
+        fclose(fp);
+        return -1;
+    }
+
+    // 2) Number the vertices: a counting sort on the label ranks keeps equal labels in input order
+    CompressedInput* ci = malloc(sizeof(CompressedInput));
+    int count = labels->count;
+    int* next = calloc(count + 1, sizeof(int));
+    if (ci == NULL || next == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    rankLabels(labels);
+    ci->labels = labels;
+    ci->labelOf = malloc((n > 0 ? n : 1) * sizeof(int));
+    ci->vertexOf = malloc((count > 0 ? count : 1) * sizeof(int));
+    ci->listDegree = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (ci->labelOf == NULL || ci->vertexOf == NULL || ci->listDegree == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (i = 0; i < n; i++) {
+        next[labels->rank[lineLabel[i]] + 1]++;
+    }
+    for (i = 0; i < count; i++) {
+        next[i + 1] += next[i];
+        ci->vertexOf[i] = -1;
+    }
+    for (i = 0; i < n; i++) {
+        int label = lineLabel[i];
+        id[i] = next[labels->rank[label]];
+        next[labels->rank[label]]++;
+        ci->labelOf[id[i]] = label;
+        if (ci->vertexOf[label] < 0) {
+            ci->vertexOf[label] = id[i];   // the first line with a label names it, like nodeVertex
+        }
+    }
+    free(next);
+    free(lineLabel);
+
+    // 3) Second pass: each line's vertex neighbors, sorted, deduplicated and encoded in input order
+    size_t* rowStart = malloc((n + 1) * sizeof(size_t));
+    size_t used = 0, rowsCap = 1024;
+    unsigned char* rows = malloc(rowsCap);
+    int rowCap = 64;
+    int* row = malloc(rowCap * sizeof(int));
+    if (rowStart == NULL || rows == NULL || row == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int numEdges = 0;
+    graphSeek(fp, recordsStart, SEEK_SET);
+    for (i = 0; i < n; i++) {
+        int v = id[i], entries = 0, k = 0;
+
+        readToken(fp, &token, &tokenCap);   // the vertex itself
+        while ((len = readToken(fp, &token, &tokenCap)) >= 0 && strcmp(token, "-1") != 0) {
+            int label = findLabel(labels, token, len);
+            int u = (label >= 0) ? ci->vertexOf[label] : -1;
+            entries++;
+            if (u >= 0 && u != v) {
+                if (k == rowCap) {
+                    rowCap *= 2;
+                    row = realloc(row, rowCap * sizeof(int));
+                    if (row == NULL) {
+                        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                        exit(1);
+                    }
+                }
+                row[k] = u;
+                k++;
+            }
+        }
+        ci->listDegree[v] = entries;
+
+        qsort(row, k, sizeof(int), compareInt);
+        int unique = 0;
+        for (int e = 0; e < k; e++) {
+            if (unique == 0 || row[unique - 1] != row[e]) {
+                row[unique] = row[e];
+                unique++;
+            }
+        }
+        if (used + ((size_t) unique + 1) * 5 > rowsCap) {
+            while (used + ((size_t) unique + 1) * 5 > rowsCap) {
+                rowsCap *= 2;
+            }
+            rows = realloc(rows, rowsCap);
+            if (rows == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+        }
+        rowStart[i] = used;
+        used += encodeNeighborBlock(rows + used, v, row, unique);
+        numEdges += unique;
+    }
+    rowStart[n] = used;
+    free(row);
+    free(token);
+    fclose(fp);
+
+    // 4) Copy the blocks into vertex (label) order
+    CompressedGraph* cg = malloc(sizeof(CompressedGraph));
+    int* lineOf = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (cg == NULL || lineOf == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    cg->numVertices = n;
+    cg->numEdges = numEdges;
+    cg->dataSize = used;
+    cg->offsets = malloc((n + 1) * sizeof(uint32_t));
+    cg->groupBase = malloc((n / COMPRESSED_GROUP + 1) * sizeof(size_t));
+    cg->data = malloc(used > 0 ? used : 1);
+    if (cg->offsets == NULL || cg->groupBase == NULL || cg->data == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (i = 0; i < n; i++) {
+        lineOf[id[i]] = i;
+    }
+    size_t pos = 0;
+    for (int v = 0; v < n; v++) {
+        size_t blockLen = rowStart[lineOf[v] + 1] - rowStart[lineOf[v]];
+        setBlockOffset(cg, v, pos);
+        memcpy(cg->data + pos, rows + rowStart[lineOf[v]], blockLen);
+        pos += blockLen;
+    }
+    setBlockOffset(cg, n, pos);
+    ci->graph = cg;
+
+    free(rows);
+    free(rowStart);
+    free(lineOf);
+    free(id);
+    *CDS = ci;
+    return 1;
+}
+
+/**
+    Purpose: Frees a CompressedInput and its compressed graph.
+    Returns: NULL
+    @param  : ci - pointer to the CompressedInput to free
+    Post-condition:
+             - Returns NULL so caller can safely do: ci = freeCompressedInput(ci);
+*/
+CompressedInput* freeCompressedInput(CompressedInput* ci) {
+    if (ci != NULL) {
+        freeCompressedGraph(ci->graph);
+        freeLabelArena(ci->labels);
+        free(ci->labelOf);
+        free(ci->vertexOf);
+        free(ci->listDegree);
+        free(ci);
+    }
+    return NULL;
+}
+
+/**
+    Purpose: Looks up a vertex of a CompressedInput by name.
+    Returns: Vertex index; -1 if no vertex has this label
+    @param  : ci   - pointer to the CompressedInput
+    @param  : name - null-terminated label
+    Post-condition:
+             - With shared labels the first input line wins, like getVertexIndex.
+*/
+int compressedVertexIndex(const CompressedInput* ci, const char* name) {
+    int label = findLabel(ci->labels, name, strlen(name));
+    return (label >= 0) ? ci->vertexOf[label] : -1;
+}
+
+/**
+    Purpose: Locates the start of a vertex's compressed block.
+    Returns: Pointer to the block's first byte
+    @param  : cg - pointer to the CompressedGraph
+    @param  : v  - vertex index (0 <= v <= numVertices)
+*/
+const unsigned char* compressedBlock(const CompressedGraph* cg, int v) {
+    return cg->data + cg->groupBase[v / COMPRESSED_GROUP] + cg->offsets[v];
+}
+
+/**
+    Purpose: Reads a vertex's degree from the head of its block.
+    Returns: Number of neighbors of v
+    @param  : cg - pointer to the CompressedGraph
+    @param  : v  - vertex index
+*/
+int compressedDegree(const CompressedGraph* cg, int v) {
+    const unsigned char* p = compressedBlock(cg, v);
+    return (int) readVarint(&p);
+}
+
+/**
+    Purpose: Positions a cursor at the start of a vertex's neighbor block.
+    Returns: void
+    @param  : cg  - pointer to the CompressedGraph
+    @param  : v   - vertex index
+    @param  : cur - cursor to initialize
+    Post-condition:
+             - nextNeighbor(cur, ...) yields v's neighbors in ascending order.
+*/
+void openNeighbors(const CompressedGraph* cg, int v, NeighborCursor* cur) {
+    cur->p = compressedBlock(cg, v);
+    cur->remaining = (int) readVarint(&cur->p);
+    cur->last = v;
+    cur->first = 1;
+}
+
+/**
+    Purpose: Decodes the next neighbor from a cursor.
+    Returns: 1 if a neighbor was produced; 0 when the block is exhausted
+    @param  : cur - cursor from openNeighbors
+    @param  : out - receives the neighbor index
+*/
+int nextNeighbor(NeighborCursor* cur, int* out) {
+    if (cur->remaining == 0) {
+        return 0;
+    }
+    unsigned int code = readVarint(&cur->p);
+    if (cur->first) {
+        cur->last += zigzagDecode(code);
+        cur->first = 0;
+    } else {
+        cur->last += (int) code + 1;
+    }
+    cur->remaining--;
+    *out = cur->last;
+    return 1;
+}
+
+/**
+    Purpose: Decodes a whole neighbor block into an int array.
+    Returns: Number of neighbors written
+    @param  : cg  - pointer to the CompressedGraph
+    @param  : v   - vertex index
+    @param  : out - destination, room for compressedDegree(cg, v) ints
+*/
+int decodeNeighbors(const CompressedGraph* cg, int v, int out[]) {
+    NeighborCursor cur;
+    int count = 0;
+    openNeighbors(cg, v, &cur);
+    while (nextNeighbor(&cur, &out[count])) {
+        count++;
+    }
+    return count;
+}
+
+/**
+    Purpose: BFS hop distances straight off the compressed blocks.
+    Returns: Eccentricity of s (largest distance to a vertex it reaches)
+    @param  : cg - pointer to the CompressedGraph
+    @param  : s  - source vertex
+    @param  : ws - reusable workspace; same contract as bfsDistances
+    Post-condition:
+             - ws->queue[0 .. ws->reached-1] is the visit order, neighbors taken in
+               index order (label order for compressGraphByLabel).
+*/
+int compressedBFS(const CompressedGraph* cg, int s, BFSWorkspace* ws) {
+    int k;
+    for (k = 0; k < ws->reached; k++) {
+        ws->dist[ws->queue[k]] = -1;
+    }
+
+    int front = 0, rear = 0;
+    ws->dist[s] = 0;
+    ws->queue[rear] = s;
+    rear++;
+    while (front < rear) {
+        int v = ws->queue[front];
+        front++;
+        NeighborCursor cur;
+        int w;
+        openNeighbors(cg, v, &cur);
+        while (nextNeighbor(&cur, &w)) {
+            if (ws->dist[w] < 0) {
+                ws->dist[w] = ws->dist[v] + 1;
+                ws->queue[rear] = w;
+                rear++;
+            }
+        }
+    }
+    ws->reached = rear;
+    return ws->dist[ws->queue[rear - 1]];
+}
+
+/**
+    Purpose: Iterative DFS preorder straight off the compressed blocks.
+    Returns: Number of vertices visited
+    @param  : cg    - pointer to the CompressedGraph
+    @param  : s     - start vertex
+    @param  : order - output; order[0..count-1] is the preorder (neighbors in index
+                      order, i.e. label order for compressGraphByLabel)
+    Pre-condition:
+             - order holds cg->numVertices ints.
+    Post-condition:
+             - The explicit stack holds one NeighborCursor per level, so deep
+               graphs cannot overflow the call stack.
+*/
+int compressedDFS(const CompressedGraph* cg, int s, int order[]) {
+    int n = cg->numVertices;
+    int* visited = calloc(n > 0 ? n : 1, sizeof(int));
+    NeighborCursor* stack = malloc((n > 0 ? n : 1) * sizeof(NeighborCursor));
+    if (visited == NULL || stack == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    int count = 0, top = 0;
+    visited[s] = 1;
+    order[count] = s;
+    count++;
+    openNeighbors(cg, s, &stack[top]);
+    top++;
+    while (top > 0) {
+        int w;
+        if (nextNeighbor(&stack[top - 1], &w)) {
+            if (!visited[w]) {
+                visited[w] = 1;
+                order[count] = w;
+                count++;
+                openNeighbors(cg, w, &stack[top]);
+                top++;
+            }
+        } else {
+            top--;
+        }
+    }
+
+    free(visited);
+    free(stack);
+    return count;
+}
+
+/**
+    Purpose: Generates the vertex degree report (<input>-DEGREE.TXT) from a CompressedInput.
+    Returns: void
+    @param  : ci            - pointer to the CompressedInput
+    @param  : inputFilename - name of the input file
+    Post-condition:
+             - Same content as ProduceDegreeFile: vertices are already numbered in
+               label order, and listDegree counts every entry of the input line.
+*/
+void ProduceCompressedDegreeFile(const CompressedInput* ci, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int i = 0;
+
+    // Create filename
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0';  // Truncate at '.' or end
+    strcat(outputFilename, "-DEGREE.TXT");
+
+    FILE* fp = fopen(outputFilename, "w");
+
+    if (fp != NULL) {
+        for (i = 0; i < ci->graph->numVertices; i++) {
+            fprintf(fp, "%s %d\n", labelText(ci->labels, ci->labelOf[i]), ci->listDegree[i]);
+        }
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: Generates a BFS or DFS traversal file (<input>-BFS.TXT / -DFS.TXT) from a CompressedInput.
+    Returns: void
+    @param  : ci            - pointer to the CompressedInput
+    @param  : inputFilename - name of the input file
+    @param  : startVertex   - name of the starting vertex
+    @param  : depthFirst    - nonzero for DFS, zero for BFS
+    Post-condition:
+             - Same content as ProduceBFSFile / ProduceDFSFile; the traversal reads
+               the delta-encoded blocks, whose ascending indices are label order.
+             - Nothing is written if startVertex does not exist.
+*/
+void ProduceCompressedTraversalFile(const CompressedInput* ci, const char* inputFilename, const char* startVertex, int depthFirst) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int i = 0;
+    int start = compressedVertexIndex(ci, startVertex);   // -1 if vertex does not exist
+
+    if (start >= 0) {
+        // Copy input filename and remove extension
+        strcpy(outputFilename, inputFilename);
+        while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+            i++;
+        }
+        outputFilename[i] = '\0'; // Truncate at '.' or end
+        strcat(outputFilename, depthFirst ? "-DFS.TXT" : "-BFS.TXT");
+
+        FILE* fp = fopen(outputFilename, "w");
+        if (fp != NULL) {
+            int n = ci->graph->numVertices;
+            int* order = malloc(n * sizeof(int));
+            if (order == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+
+            int count;
+            if (depthFirst) {
+                count = compressedDFS(ci->graph, start, order);
+            } else {
+                BFSWorkspace ws;
+                initBFSWorkspace(&ws, n);
+                compressedBFS(ci->graph, start, &ws);
+                count = ws.reached;
+                memcpy(order, ws.queue, count * sizeof(int));
+                freeBFSWorkspace(&ws);
+            }
+            for (int k = 0; k < count; k++) {
+                if (k > 0) {
+                    fputc(' ', fp);
+                }
+                fputs(labelText(ci->labels, ci->labelOf[order[k]]), fp);
+            }
+
+            free(order);
+            fclose(fp);
+        }
+    }
+}
+
+/**
+    Purpose: Converts a text input file into the on-disk indexed graph format without loading the graph.
+    Returns: 1 if successful; 0 if a file cannot be opened or the input is short.
+    @param  : strInputFileName - text input in the ReadInputFile format
+    @param  : graphFileName    - binary file to create
+    Pre-condition:
+             - Both names must be valid, null-terminated strings.
+    Post-condition:
+             - Layout: OOC_MAGIC, then six uint64 fields (numVertices, numNames,
+               numEdges, dataSize, labelBytes, extraBytes), the vertex labels
+               (null-terminated, in input order), numVertices + 1 data offsets,
+               the adjacency data, and last the dangling neighbor labels.
+             - Neighbors are name ids: a vertex index, or numVertices + k for the
+               k-th distinct neighbor label that is not a vertex. Those are kept
+               so LIST and DEGREE match the in-memory reports.
+             - Each vertex's block is a varint count followed by its neighbors as
+               zigzag deltas from the previous one (starting from the vertex), in
+               input order, so LIST output is reproduced exactly.
+             - Two streaming passes: the first collects vertex labels into a label
+               arena, the second encodes one adjacency line at a time. Memory is
+               O(V + label bytes + max degree).
+             - Offsets and counts are 64-bit; values are stored in native byte
+               order (a machine-local format).
+*/
+int ConvertInputToGraphFile(strFile strInputFileName, const char* graphFileName) {
+    FILE* in = fopen(strInputFileName, "r");
+    if (in == NULL) {
+        return 0;
+    }
+    int numVertex = 0;
+    if (fscanf(in, "%d", &numVertex) != 1 || numVertex < 0) {
+        fclose(in);
+        return 0;
+    }
+
+    LabelArena* labels = createLabelArena(numVertex);
+    int* labelOf = malloc((numVertex > 0 ? numVertex : 1) * sizeof(int));
+    int* vertexOf = malloc((numVertex > 0 ? numVertex : 1) * sizeof(int));
+    uint64_t* offsets = malloc((numVertex + 1) * sizeof(uint64_t));
+    size_t tokenCap = 64;
+    char* token = malloc(tokenCap);
+    if (labelOf == NULL || vertexOf == NULL || offsets == NULL || token == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    // 1) First pass: vertex labels only
+    long long dataStartInput = graphTell(in);
+    int i, len, ok = 1;
+    uint64_t labelBytes = 0;
+    for (i = 0; i < numVertex && ok; i++) {
+        len = readToken(in, &token, &tokenCap);
+        ok = (len >= 0);
+        if (ok) {
+            int known = labels->count;
+            labelOf[i] = internLabel(labels, token, len);
+            if (labels->count != known) {
+                vertexOf[labelOf[i]] = i;   // first vertex with this label
+            }
+            labelBytes += (uint64_t) len + 1;
+        }
+        while (ok && readToken(in, &token, &tokenCap) >= 0 && strcmp(token, "-1") != 0) {
+            // skip neighbors
+        }
+    }
+
+    FILE* out = ok ? fopen(graphFileName, "wb") : NULL;
+    if (out == NULL) {
+        freeLabelArena(labels);
+        free(labelOf);
+        free(vertexOf);
+        free(offsets);
+        free(token);
+        fclose(in);
+        return 0;
+    }
+
+    // 2) Header and labels; counts and offsets are patched in once the data is written
+    int vertexLabels = labels->count;   // label ids from here on are dangling neighbors
+    uint64_t header[6] = { (uint64_t) numVertex, (uint64_t) numVertex, 0, 0, labelBytes, 0 };
+    uint64_t dataSize = 0, extraBytes = 0;
+    fwrite(OOC_MAGIC, 1, 8, out);
+    fwrite(header, sizeof(uint64_t), 6, out);
+    for (i = 0; i < numVertex; i++) {
+        fwrite(labelText(labels, labelOf[i]), 1, labels->refs[labelOf[i]].length + 1, out);
+    }
+    long long offsetsPos = graphTell(out);
+    fwrite(offsets, sizeof(uint64_t), numVertex + 1, out);
+
+    // 3) Second pass: encode each adjacency line
+    int cap = 64;
+    unsigned char* block = malloc(cap * 5 + 5);
+    if (block == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    graphSeek(in, dataStartInput, SEEK_SET);
+    for (i = 0; i < numVertex; i++) {
+        int count = 0, last = i;
+        size_t blockLen = 0;
+        unsigned char countBytes[5];
+
+        readToken(in, &token, &tokenCap);   // the vertex itself
+        while ((len = readToken(in, &token, &tokenCap)) >= 0 && strcmp(token, "-1") != 0) {
+            int label = findLabel(labels, token, len);
+            if (label < 0) {
+                label = internLabel(labels, token, len);   // not a vertex
+                extraBytes += (uint64_t) len + 1;
+            }
+            int id = (label < vertexLabels) ? vertexOf[label] : numVertex + (label - vertexLabels);
+            if (count == cap) {
+                cap *= 2;
+                block = realloc(block, cap * 5 + 5);
+                if (block == NULL) {
+                    fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                    exit(1);
+                }
+            }
+            blockLen += writeVarint(block + blockLen, zigzagEncode(id - last));
+            last = id;
+            count++;
+        }
+
+        offsets[i] = dataSize;
+        int countLen = writeVarint(countBytes, (unsigned int) count);
+        fwrite(countBytes, 1, countLen, out);
+        fwrite(block, 1, blockLen, out);
+        dataSize += countLen + blockLen;
+        header[2] += count;
+    }
+    offsets[numVertex] = dataSize;
+    for (int label = vertexLabels; label < labels->count; label++) {
+        fwrite(labelText(labels, label), 1, labels->refs[label].length + 1, out);
+    }
+
+    // 4) Patch the header and offset index
+    header[1] = (uint64_t) numVertex + (labels->count - vertexLabels);
+    header[3] = dataSize;
+    header[5] = extraBytes;
+    graphSeek(out, 8, SEEK_SET);
+    fwrite(header, sizeof(uint64_t), 6, out);
+    graphSeek(out, offsetsPos, SEEK_SET);
+    fwrite(offsets, sizeof(uint64_t), numVertex + 1, out);
+    ok = !ferror(out);
+
+    free(block);
+    freeLabelArena(labels);
+    free(labelOf);
+    free(vertexOf);
+    free(offsets);
+    free(token);
+    fclose(in);
+    fclose(out);
+    return ok;
+}
+
+/**
+    Purpose: Opens an on-disk graph file with a bounded page cache.
+    Returns: Pointer to the new OOCGraph; NULL if the file cannot be opened or is not a graph file
+    @param  : graphFileName - file written by ConvertInputToGraphFile
+    @param  : cachePages    - number of OOC_PAGE_SIZE pages kept in memory (at least 1)
+    Post-condition:
+             - Resident memory is the vertex labels and offsets plus
+               cachePages * OOC_PAGE_SIZE bytes; adjacency data stays on disk.
+*/
+OOCGraph* openGraphFile(const char* graphFileName, int cachePages) {
+    FILE* fp = fopen(graphFileName, "rb");
+    if (fp == NULL) {
+        return NULL;
+    }
+    char magic[8];
+    uint64_t header[6];   // numVertices, numNames, numEdges, dataSize, labelBytes, extraBytes
+    if (fread(magic, 1, 8, fp) != 8 || memcmp(magic, OOC_MAGIC, 8) != 0 ||
+        fread(header, sizeof(uint64_t), 6, fp) != 6 ||
+        header[1] < header[0] || header[1] > INT_MAX) {
+        fclose(fp);
+        return NULL;
+    }
+    uint64_t dataSize = header[3], labelBytes = header[4], extraBytes = header[5];
+
+    OOCGraph* g = malloc(sizeof(OOCGraph));
+    if (g == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int n = (int) header[0];
+    int names = (int) header[1];
+    g->fp = fp;
+    g->numVertices = n;
+    g->numNames = names;
+    g->numEdges = header[2];
+    g->dataSize = dataSize;
+    g->dataStart = 8 + 6 * sizeof(uint64_t) + labelBytes + (uint64_t) (n + 1) * sizeof(uint64_t);
+    char* text = malloc(labelBytes + extraBytes > 0 ? labelBytes + extraBytes : 1);
+    g->labels = createLabelArena(names);
+    g->labelOf = malloc((names > 0 ? names : 1) * sizeof(int));
+    g->vertexOf = malloc((names > 0 ? names : 1) * sizeof(int));
+    g->offsets = malloc((n + 1) * sizeof(uint64_t));
+    if (text == NULL || g->labelOf == NULL || g->vertexOf == NULL || g->offsets == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    if (fread(text, 1, labelBytes, fp) != labelBytes ||
+        fread(g->offsets, sizeof(uint64_t), n + 1, fp) != (size_t) n + 1 ||
+        graphSeek(fp, g->dataStart + dataSize, SEEK_SET) != 0 ||
+        fread(text + labelBytes, 1, extraBytes, fp) != extraBytes) {
+        free(text);
+        g->fp = NULL;
+        g->cache = NULL;
+        g->slotPage = NULL;
+        g->slotRef = NULL;
+        g->pageSlot = NULL;
+        closeGraphFile(g);
+        fclose(fp);
+        return NULL;
+    }
+
+    // labels are stored back to back in name id order, dangling ones last
+    size_t pos = 0;
+    for (int v = 0; v < names; v++) {
+        size_t len = strlen(text + pos);
+        int known = g->labels->count;
+        g->labelOf[v] = internLabel(g->labels, text + pos, len);
+        if (g->labels->count != known) {
+            g->vertexOf[g->labelOf[v]] = (v < n) ? v : -1;
+        }
+        pos += len + 1;
+    }
+    free(text);
+    rankLabels(g->labels);
+
+    // page cache
+    g->numSlots = cachePages > 0 ? cachePages : 1;
+    g->numPages = (dataSize + OOC_PAGE_SIZE - 1) / OOC_PAGE_SIZE;
+    g->cache = malloc((size_t) g->numSlots * OOC_PAGE_SIZE);
+    g->slotPage = malloc(g->numSlots * sizeof(long long));
+    g->slotRef = calloc(g->numSlots, 1);
+    g->pageSlot = malloc((g->numPages > 0 ? g->numPages : 1) * sizeof(int));
+    if (g->cache == NULL || g->slotPage == NULL || g->slotRef == NULL || g->pageSlot == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int s;
+    long long p;
+    for (s = 0; s < g->numSlots; s++) {
+        g->slotPage[s] = -1;
+    }
+    for (p = 0; p < g->numPages; p++) {
+        g->pageSlot[p] = -1;
+    }
+    g->hand = 0;
+    g->hits = 0;
+    g->misses = 0;
+    return g;
+}
+
+/**
+    Purpose: Closes an on-disk graph and frees its cache.
+    Returns: NULL
+    @param  : g - pointer to the OOCGraph
+    Post-condition:
+             - Returns NULL so caller can safely do: g = closeGraphFile(g);
+*/
+OOCGraph* closeGraphFile(OOCGraph* g) {
+    if (g != NULL) {
+        if (g->fp != NULL) {
+            fclose(g->fp);
+        }
+        freeLabelArena(g->labels);
+        free(g->labelOf);
+        free(g->vertexOf);
+        free(g->offsets);
+        free(g->cache);
+        free(g->slotPage);
+        free(g->slotRef);
+        free(g->pageSlot);
+        free(g);
+    }
+    return NULL;
+}
+
+/**
+    Purpose: Returns a cached data page, reading it from disk on a miss.
+    Returns: Pointer to the first byte of the page in the cache
+    @param  : g    - pointer to the OOCGraph
+    @param  : page - page number within the adjacency data
+    Post-condition:
+             - On a miss the clock hand evicts the first slot whose reference bit is
+               clear (clearing bits as it passes), so hot pages survive.
+             - The pointer stays valid only until the next page is loaded.
+*/
+const unsigned char* oocPage(OOCGraph* g, long long page) {
+    int slot = g->pageSlot[page];
+    if (slot >= 0) {
+        g->slotRef[slot] = 1;
+        g->hits++;
+        return g->cache + (size_t) slot * OOC_PAGE_SIZE;
+    }
+    g->misses++;
+
+    while (g->slotRef[g->hand]) {
+        g->slotRef[g->hand] = 0;
+        g->hand = (g->hand + 1) % g->numSlots;
+    }
+    slot = g->hand;
+    g->hand = (g->hand + 1) % g->numSlots;
+    if (g->slotPage[slot] >= 0) {
+        g->pageSlot[g->slotPage[slot]] = -1;
+    }
+
+    uint64_t begin = (uint64_t) page * OOC_PAGE_SIZE;
+    size_t len = OOC_PAGE_SIZE;
+    if (begin + len > g->dataSize) {
+        len = (size_t) (g->dataSize - begin);
+    }
+    unsigned char* dst = g->cache + (size_t) slot * OOC_PAGE_SIZE;
+    if (graphSeek(g->fp, g->dataStart + begin, SEEK_SET) != 0 || fread(dst, 1, len, g->fp) != len) {
+        fprintf(stderr, "Error: GRAPH FILE READ FAILED!\n");
+        exit(1);
+    }
+
+    g->slotPage[slot] = page;
+    g->pageSlot[page] = slot;
+    g->slotRef[slot] = 1;
+    return dst;
+}
+
+/**
+    Purpose: Decodes a varint from the adjacency data through the page cache.
+    Returns: The decoded value
+    @param  : g   - pointer to the OOCGraph
+    @param  : pos - address of the data offset; advanced past the varint
+*/
+unsigned int oocReadVarint(OOCGraph* g, uint64_t* pos) {
+    unsigned int value = 0;
+    int shift = 0;
+    unsigned char byte;
+    do {
+        byte = oocPage(g, (long long) (*pos / OOC_PAGE_SIZE))[*pos % OOC_PAGE_SIZE];
+        value |= (unsigned int) (byte & 0x7F) << shift;
+        shift += 7;
+        (*pos)++;
+    } while (byte & 0x80);
+    return value;
+}
+
+/**
+    Purpose: Reads a vertex's degree from its on-disk block.
+    Returns: Number of neighbors of v
+    @param  : g - pointer to the OOCGraph
+    @param  : v - vertex index
+*/
+int oocDegree(OOCGraph* g, int v) {
+    uint64_t pos = g->offsets[v];
+    return (int) oocReadVarint(g, &pos);
+}
+
+/**
+    Purpose: Reads all neighbors of a vertex, in input order, into a growable buffer.
+    Returns: Number of neighbors read
+    @param  : g   - pointer to the OOCGraph
+    @param  : v   - vertex index
+    @param  : buf - address of a malloc'd int buffer (may be reallocated)
+    @param  : cap - address of the buffer's capacity
+    Post-condition:
+             - (*buf)[k] is a name id; ids >= g->numVertices are neighbor labels
+               that are not vertices.
+*/
+int oocNeighbors(OOCGraph* g, int v, int** buf, int* cap) {
+    uint64_t pos = g->offsets[v];
+    int count = (int) oocReadVarint(g, &pos);
+    if (count > *cap) {
+        *cap = count;
+        *buf = realloc(*buf, count * sizeof(int));
+        if (*buf == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+    }
+    int last = v;
+    for (int k = 0; k < count; k++) {
+        last += zigzagDecode(oocReadVarint(g, &pos));
+        (*buf)[k] = last;
+    }
+    return count;
+}
+
+/**
+    Purpose: Finds a vertex of an on-disk graph by label.
+    Returns: Index of the vertex if found; -1 otherwise
+    @param  : g    - pointer to the OOCGraph
+    @param  : name - vertex name to search
+*/
+int oocVertexIndex(const OOCGraph* g, const char* name) {
+    int label = findLabel(g->labels, name, strlen(name));
+    return (label >= 0) ? g->vertexOf[label] : -1;
+}
+
+/**
+    Purpose: Returns the label of a vertex (or dangling neighbor) of an on-disk graph.
+    Returns: Null-terminated label text, owned by g
+    @param  : g - pointer to the OOCGraph
+    @param  : v - name id (0 <= v < g->numNames)
+*/
+const char* oocVertexLabel(const OOCGraph* g, int v) {
+    return labelText(g->labels, g->labelOf[v]);
+}
+
+/**
+    Purpose: Returns the label sort key of a vertex of an on-disk graph.
+    Returns: Key ordering vertices like strcmp on their labels
+    @param  : g - pointer to the OOCGraph
+    @param  : v - vertex index
+*/
+LabelKey oocVertexKey(const OOCGraph* g, int v) {
+    return g->labels->rank[g->labelOf[v]];
+}
+
+/**
+    Purpose: Reads a vertex's neighbors and sorts them by label (the order BFS/DFS visit them in).
+    Returns: Number of neighbors that are vertices
+    @param  : g   - pointer to the OOCGraph
+    @param  : v   - vertex index
+    @param  : buf - address of a malloc'd KeyIndex buffer (may be reallocated)
+    @param  : cap - address of the buffer's capacity
+    Post-condition:
+             - (*buf)[k].index is the k-th neighbor; dangling labels are dropped,
+               as getSortedNeighbors drops them, and the row is sorted with qsort.
+*/
+int oocSortedNeighbors(OOCGraph* g, int v, KeyIndex** buf, int* cap) {
+    uint64_t pos = g->offsets[v];
+    int count = (int) oocReadVarint(g, &pos);
+    if (count > *cap) {
+        *cap = count;
+        *buf = realloc(*buf, count * sizeof(KeyIndex));
+        if (*buf == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+    }
+    int kept = 0, last = v;
+    for (int k = 0; k < count; k++) {
+        last += zigzagDecode(oocReadVarint(g, &pos));
+        if (last < g->numVertices) {
+            (*buf)[kept].key = oocVertexKey(g, last);
+            (*buf)[kept].index = last;
+            kept++;
+        }
+    }
+    // equal keys mean the same vertex, so qsort's instability cannot reorder them
+    qsort(*buf, kept, sizeof(KeyIndex), compareKeyIndex);
+    return kept;
+}
+
+/**
+    Purpose: Streams a label-ordered BFS over an on-disk graph to a visitor.
+    Returns: Number of vertices visited
+    @param  : g     - pointer to the OOCGraph
+    @param  : start - index of the start vertex
+    @param  : visit - callback per visited vertex; nonzero return stops the traversal
+    @param  : ctx   - caller data passed through to visit
+    Post-condition:
+             - Same order as BFSVisit on the in-memory graph; memory is O(V) plus
+               the page cache and one adjacency row.
+*/
+int oocBFSVisit(OOCGraph* g, int start, OOCVisitor visit, void* ctx) {
+    int n = g->numVertices;
+    char* visited = calloc(n, 1);
+    int* queue = malloc(n * sizeof(int));
+    int* depth = malloc(n * sizeof(int));
+    int cap = 64;
+    KeyIndex* nb = malloc(cap * sizeof(KeyIndex));
+    if (visited == NULL || queue == NULL || depth == NULL || nb == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    int front = 0, rear = 0, stopped = 0;
+    visited[start] = 1;
+    depth[start] = 0;
+    queue[rear] = start;
+    rear++;
+    while (front < rear && !stopped) {
+        int v = queue[front];
+        front++;
+        if (visit != NULL && visit(g, v, depth[v], ctx)) {
+            stopped = 1;
+        } else {
+            int cnt = oocSortedNeighbors(g, v, &nb, &cap);
+            for (int k = 0; k < cnt; k++) {
+                int u = nb[k].index;
+                if (!visited[u]) {
+                    visited[u] = 1;
+                    depth[u] = depth[v] + 1;
+                    queue[rear] = u;
+                    rear++;
+                }
+            }
+        }
+    }
+
+    free(visited);
+    free(queue);
+    free(depth);
+    free(nb);
+    return front;
+}
+
+/**
+    Purpose: Streams a label-ordered DFS over an on-disk graph to a visitor.
+    Returns: Number of vertices visited
+    @param  : g     - pointer to the OOCGraph
+    @param  : start - index of the start vertex
+    @param  : visit - callback per visited vertex; nonzero return stops the traversal
+    @param  : ctx   - caller data passed through to visit
+    Post-condition:
+             - Same order as DFSVisit on the in-memory graph. Each frame keeps its
+               sorted neighbor row on one shared int stack, so there is no
+               call-stack recursion and no V-sized array per level.
+*/
+int oocDFSVisit(OOCGraph* g, int start, OOCVisitor visit, void* ctx) {
+    int n = g->numVertices;
+    char* visited = calloc(n, 1);
+    DFSFrame* frames = malloc(n * sizeof(DFSFrame));
+    int pendingCap = 64, rowCap = 64;
+    int* pending = malloc(pendingCap * sizeof(int));
+    KeyIndex* row = malloc(rowCap * sizeof(KeyIndex));
+    if (visited == NULL || frames == NULL || pending == NULL || row == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    int top = 0, pendingTop = 0, count = 0;
+    int v = start;
+    int stopped = 0;
+    while (v >= 0 && !stopped) {
+        // enter v: report it and push its sorted neighbors
+        visited[v] = 1;
+        count++;
+        if (visit != NULL && visit(g, v, top, ctx)) {
+            stopped = 1;
+        } else {
+            int cnt = oocSortedNeighbors(g, v, &row, &rowCap);
+            if (pendingTop + cnt > pendingCap) {
+                while (pendingTop + cnt > pendingCap) {
+                    pendingCap *= 2;
+                }
+                pending = realloc(pending, pendingCap * sizeof(int));
+                if (pending == NULL) {
+                    fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                    exit(1);
+                }
+            }
+            for (int k = 0; k < cnt; k++) {
+                pending[pendingTop + k] = row[k].index;
+            }
+            frames[top].begin = pendingTop;
+            frames[top].next = pendingTop;
+            frames[top].end = pendingTop + cnt;
+            pendingTop += cnt;
+            top++;
+
+            // find the next unvisited vertex, popping exhausted frames
+            v = -1;
+            while (v < 0 && top > 0) {
+                DFSFrame* f = &frames[top - 1];
+                while (f->next < f->end && visited[pending[f->next]]) {
+                    f->next++;
+                }
+                if (f->next < f->end) {
+                    v = pending[f->next];
+                    f->next++;
+                } else {
+                    pendingTop = f->begin;
+                    top--;
+                }
+            }
+        }
+    }
+
+    free(visited);
+    free(frames);
+    free(pending);
+    free(row);
+    return count;
+}
+
+/**
+    Purpose: Visitor that writes each visited vertex label of an on-disk graph, space separated.
+    Returns: 0 (never stops the traversal)
+    @param  : g      - pointer to the OOCGraph
+    @param  : vIndex - index of the visited vertex
+    @param  : depth  - unused
+    @param  : ctx    - pointer to a TraversalWriter
+*/
+int oocWriteVisitor(const OOCGraph* g, int vIndex, int depth, void* ctx) {
+    TraversalWriter* w = ctx;
+    (void) depth;
+    if (w->count > 0) {
+        fputc(' ', w->fp);
+    }
+    fputs(oocVertexLabel(g, vIndex), w->fp);
+    w->count++;
+    return 0;
+}
+
+/**
+    Purpose: Generates the vertex degree report (<input>-DEGREE.TXT) from an on-disk graph.
+    Returns: void
+    @param  : g             - pointer to the OOCGraph
+    @param  : inputFilename - name of the input file
+    Post-condition:
+             - Same content as ProduceDegreeFile (dangling neighbors count); degrees
+               are read from the block headers, one small read per vertex.
+*/
+void ProduceOOCDegreeFile(OOCGraph* g, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int i = 0;
+
+    // Create filename
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0';  // Truncate at '.' or end
+    strcat(outputFilename, "-DEGREE.TXT");
+
+    FILE* fp = fopen(outputFilename, "w");
+
+    if (fp != NULL) {
+        int n = g->numVertices;
+        KeyIndex* byLabel = malloc((n > 0 ? n : 1) * sizeof(KeyIndex));
+        if (byLabel == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        for (i = 0; i < n; i++) {
+            byLabel[i].key = oocVertexKey(g, i);
+            byLabel[i].index = i;
+        }
+        qsort(byLabel, n, sizeof(KeyIndex), compareKeyIndex);
+
+        for (i = 0; i < n; i++) {
+            int v = byLabel[i].index;
+            fprintf(fp, "%s %d\n", oocVertexLabel(g, v), oocDegree(g, v));
+        }
+        free(byLabel);
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: Generates the adjacency list report (<input>-LIST.TXT) from an on-disk graph.
+    Returns: void
+    @param  : g             - pointer to the OOCGraph
+    @param  : inputFilename - name of the input file
+    Post-condition:
+             - Same content as ProduceListFile; blocks are read sequentially, so the
+               page cache sees one pass over the data.
+*/
+void ProduceOOCListFile(OOCGraph* g, const char* inputFilename) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int i = 0;
+
+    // Copy input filename and remove extension
+    strcpy(outputFilename, inputFilename);
+    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+        i++;
+    }
+    outputFilename[i] = '\0'; // Truncate at '.' or end
+    strcat(outputFilename, "-LIST.TXT");
+
+    FILE* fp = fopen(outputFilename, "w");
+
+    if (fp != NULL) {
+        int cap = 64;
+        int* nb = malloc(cap * sizeof(int));
+        if (nb == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        for (i = 0; i < g->numVertices; i++) {
+            fprintf(fp, "%s", oocVertexLabel(g, i));
+
+            int cnt = oocNeighbors(g, i, &nb, &cap);
+            for (int k = 0; k < cnt; k++) {
+                fprintf(fp, "->%s", oocVertexLabel(g, nb[k]));
+            }
+            fprintf(fp, "->\\\n");
+        }
+        free(nb);
+        fclose(fp);
+    }
+}
+
+/**
+    Purpose: Generates a BFS or DFS traversal file (<input>-BFS.TXT / -DFS.TXT) from an on-disk graph.
+    Returns: void
+    @param  : g             - pointer to the OOCGraph
+    @param  : inputFilename - name of the input file
+    @param  : startVertex   - name of the starting vertex
+    @param  : depthFirst    - nonzero for DFS, zero for BFS
+    Post-condition:
+             - Same content as ProduceBFSFile / ProduceDFSFile; nothing is written
+               if startVertex does not exist.
+*/
+void ProduceOOCTraversalFile(OOCGraph* g, const char* inputFilename, const char* startVertex, int depthFirst) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int i = 0;
+    int start = oocVertexIndex(g, startVertex);   // -1 if vertex does not exist
+
+    if (start >= 0) {
+        // Copy input filename and remove extension
+        strcpy(outputFilename, inputFilename);
+        while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
+            i++;
+        }
+        outputFilename[i] = '\0'; // Truncate at '.' or end
+        strcat(outputFilename, depthFirst ? "-DFS.TXT" : "-BFS.TXT");
+
+        FILE* fp = fopen(outputFilename, "w");
+        if (fp != NULL) {
+            TraversalWriter w = { fp, 0 };
+            if (depthFirst) {
+                oocDFSVisit(g, start, oocWriteVisitor, &w);
+            } else {
+                oocBFSVisit(g, start, oocWriteVisitor, &w);
+            }
+            fclose(fp);
+        }
+    }
+}
+
+/**
+    Purpose: Makes a deep copy of a graph, for copy-on-write updates.
+    Returns: Pointer to the new Graph
+    @param  : g - graph to copy
+    Pre-condition:
+             - g must not be NULL.
+    Post-condition:
+             - Lists, input order, label arena and index are all copied; g is unchanged,
+               so readers of g are unaffected by edits to the copy.
+             - Program exits on malloc failure.
+*/
+Graph* cloneGraph(const Graph* g) {
+    Graph* copy = createGraph(g->numVertices);
+    if (copy == NULL) {
+        exit(1);
+    }
+    int n = g->numVertices;
+    for (int i = 0; i < n; i++) {
+        for (Node* cur = g->adjList[i].head; cur != NULL; cur = cur->edge) {
+            appendNode(&copy->adjList[i], cur->label);
+        }
+    }
+    if (g->inputOrder != NULL) {
+        copy->inputOrder = malloc(n * sizeof(int));
+        if (copy->inputOrder == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        memcpy(copy->inputOrder, g->inputOrder, n * sizeof(int));
+    }
+    freeLabelArena(copy->labels);
+    copy->labels = cloneLabelArena(g->labels);
+    if (g->labelVertex != NULL) {
+        int count = g->labels->count;
+        copy->labelVertex = malloc((count > 0 ? count : 1) * sizeof(int));
+        if (copy->labelVertex == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        memcpy(copy->labelVertex, g->labelVertex, count * sizeof(int));
+    }
+    return copy;
+}
+
+/**
+    Purpose: Creates a store that publishes immutable graph versions to concurrent readers.
+    Returns: Pointer to the new GraphStore
+    @param  : initial    - first published version (the store takes ownership)
+    @param  : maxReaders - number of reader slots (reader ids 0 .. maxReaders-1)
+    Post-condition:
+             - Readers use snapshotAcquire / snapshotRelease around each read;
+               a writer edits a cloneGraph copy and hands it to publishGraph.
+             - Every version is a whole graph, so an update costs O(V + E) for the
+               copy; batch edits into one publish rather than publishing each.
+             - Program exits on malloc failure.
+*/
+GraphStore* createGraphStore(Graph* initial, int maxReaders) {
+    GraphStore* s = malloc(sizeof(GraphStore));
+    if (s == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    s->maxReaders = maxReaders > 0 ? maxReaders : 1;
+    s->readerEpoch = malloc(s->maxReaders * sizeof(*s->readerEpoch));
+    s->retiredCap = 8;
+    s->retired = malloc(s->retiredCap * sizeof(RetiredGraph));
+    if (s->readerEpoch == NULL || s->retired == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (int r = 0; r < s->maxReaders; r++) {
+        atomic_init(&s->readerEpoch[r], EPOCH_IDLE);
+    }
+#ifdef _WIN32
+    InitializeSRWLock(&s->writer);
+#else
+    pthread_mutex_init(&s->writer, NULL);
+#endif
+    atomic_init(&s->current, initial);
+    atomic_init(&s->epoch, 0);
+    s->numRetired = 0;
+    return s;
+}
+
+/**
+    Purpose: Pins the current graph version for one reader.
+    Returns: The pinned graph; valid until snapshotRelease for the same reader
+    @param  : s        - pointer to the GraphStore
+    @param  : readerId - this reader's slot, unique among concurrent readers
+    Post-condition:
+             - The reader announces the epoch before loading the version, so a
+               writer that retires the version afterwards sees the announcement
+               and keeps it alive. No locks are taken.
+*/
+const Graph* snapshotAcquire(GraphStore* s, int readerId) {
+    atomic_store(&s->readerEpoch[readerId], atomic_load(&s->epoch));
+    return atomic_load(&s->current);
+}
+
+/**
+    Purpose: Unpins the version held by one reader.
+    Returns: void
+    @param  : s        - pointer to the GraphStore
+    @param  : readerId - slot passed to snapshotAcquire
+    Post-condition:
+             - The graph returned by snapshotAcquire must not be used afterwards.
+*/
+void snapshotRelease(GraphStore* s, int readerId) {
+    atomic_store(&s->readerEpoch[readerId], EPOCH_IDLE);
+}
+
+/**
+    Purpose: Takes the store's writer mutex.
+    Returns: void
+    @param  : s - pointer to the GraphStore
+*/
+void lockGraphStore(GraphStore* s) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&s->writer);
+#else
+    pthread_mutex_lock(&s->writer);
+#endif
+}
+
+/**
+    Purpose: Releases the store's writer mutex.
+    Returns: void
+    @param  : s - pointer to the GraphStore
+*/
+void unlockGraphStore(GraphStore* s) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&s->writer);
+#else
+    pthread_mutex_unlock(&s->writer);
+#endif
+}
+
+/**
+    Purpose: Frees retired versions that no reader can still hold.
+    Returns: Number of versions freed
+    @param  : s - pointer to the GraphStore
+    Pre-condition:
+             - The caller holds the writer mutex (see reclaimSnapshots).
+    Post-condition:
+             - A version retired in epoch e is freed once every active reader
+               announced an epoch after e.
+*/
+int reclaimRetired(GraphStore* s) {
+    uint64_t oldest = EPOCH_IDLE;
+    int r, kept = 0, freed = 0;
+    for (r = 0; r < s->maxReaders; r++) {
+        uint64_t e = atomic_load(&s->readerEpoch[r]);
+        if (e < oldest) {
+            oldest = e;
+        }
+    }
+    for (r = 0; r < s->numRetired; r++) {
+        if (s->retired[r].epoch < oldest) {
+            freeGraph(s->retired[r].graph);
+            freed++;
+        } else {
+            s->retired[kept] = s->retired[r];
+            kept++;
+        }
+    }
+    s->numRetired = kept;
+    return freed;
+}
+
+/**
+    Purpose: Frees retired versions that no reader can still hold, without publishing.
+    Returns: Number of versions freed
+    @param  : s - pointer to the GraphStore
+    Post-condition:
+             - publishGraph only reclaims when it runs, so the version it retired
+               last stays allocated until the next publish; call this once readers
+               have moved on (e.g. after the final publish) to free it earlier.
+             - Safe to call from any thread; it takes the writer mutex.
+*/
+int reclaimSnapshots(GraphStore* s) {
+    lockGraphStore(s);
+    int freed = reclaimRetired(s);
+    unlockGraphStore(s);
+    return freed;
+}
+
+/**
+    Purpose: Publishes a new graph version, retiring the previous one.
+    Returns: void
+    @param  : s    - pointer to the GraphStore
+    @param  : next - new version (the store takes ownership; must not be edited after)
+    Post-condition:
+             - Readers acquiring from now on get next; readers already holding the
+               old version keep using it until they release.
+             - Writers from any threads are serialized by the store's mutex.
+             - The old version is retired, and earlier ones no reader holds are
+               freed; see reclaimSnapshots for the last one.
+*/
+void publishGraph(GraphStore* s, Graph* next) {
+    lockGraphStore(s);
+    Graph* old = atomic_exchange(&s->current, next);
+    uint64_t retiredAt = atomic_fetch_add(&s->epoch, 1);
+
+    if (s->numRetired == s->retiredCap) {
+        s->retiredCap *= 2;
+        s->retired = realloc(s->retired, s->retiredCap * sizeof(RetiredGraph));
+        if (s->retired == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+    }
+    s->retired[s->numRetired].graph = old;
+    s->retired[s->numRetired].epoch = retiredAt;
+    s->numRetired++;
+    reclaimRetired(s);
+    unlockGraphStore(s);
+}
+
+/**
+    Purpose: Frees a GraphStore with its current and retired versions.
+    Returns: NULL
+    @param  : s - pointer to the GraphStore
+    Pre-condition:
+             - No reader may still hold a snapshot.
+    Post-condition:
+             - Returns NULL so caller can safely do: s = freeGraphStore(s);
+*/
+GraphStore* freeGraphStore(GraphStore* s) {
+    if (s != NULL) {
+        for (int r = 0; r < s->numRetired; r++) {
+            freeGraph(s->retired[r].graph);
+        }
+        freeGraph(atomic_load(&s->current));
+#ifndef _WIN32
+        pthread_mutex_destroy(&s->writer);
+#endif
+        free(s->retired);
+        free(s->readerEpoch);
+        free(s);
+    }
+    return NULL;
+}
+
+/**
+    Purpose: Labels the connected components of an undirected graph.
+    Returns: Number of components
+    @param  : csr  - CSR form of the graph (each edge listed at both ends)
+    @param  : comp - output; comp[v] = smallest vertex index in v's component
+    Post-condition:
+             - One BFS per component, started from its smallest vertex.
+             - Program exits on malloc failure.
+*/
+int labelComponents(const GraphCSR* csr, int comp[]) {
+    int n = csr->numVertices;
+    int* queue = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (queue == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int v, count = 0;
+    for (v = 0; v < n; v++) {
+        comp[v] = -1;
+    }
+    for (v = 0; v < n; v++) {
+        if (comp[v] < 0) {
+            int front = 0, rear = 0;
+            comp[v] = v;
+            queue[rear] = v;
+            rear++;
+            while (front < rear) {
+                int u = queue[front];
+                front++;
+                for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                    int w = csr->neighbors[e];
+                    if (comp[w] < 0) {
+                        comp[w] = v;
+                        queue[rear] = w;
+                        rear++;
+                    }
+                }
+            }
+            count++;
+        }
+    }
+    free(queue);
+    return count;
+}
+
+/**
+    Purpose: Finds which shard owns a vertex.
+    Returns: Shard number in 0 .. numShards-1
+    @param  : sg - pointer to the ShardedGraph
+    @param  : v  - vertex index
+*/
+int shardOwner(const ShardedGraph* sg, int v) {
+    if (sg->mode == PARTITION_RANGE) {
+        return v / sg->rangeSize;
+    }
+    return v % sg->numShards;
+}
+
+/**
+    Purpose: Finds a vertex's position among the vertices of its shard.
+    Returns: Local index within shard shardOwner(sg, v)
+    @param  : sg - pointer to the ShardedGraph
+    @param  : v  - vertex index
+*/
+int shardLocalIndex(const ShardedGraph* sg, int v) {
+    if (sg->mode == PARTITION_RANGE) {
+        return v % sg->rangeSize;
+    }
+    return v / sg->numShards;
+}
+
+/**
+    Purpose: Partitions a graph by vertex into shards, each holding only its own rows.
+    Returns: Pointer to the new ShardedGraph
+    @param  : g         - pointer to the Graph
+    @param  : numShards - number of shards (at least 1)
+    @param  : mode      - PARTITION_HASH (v mod N) or PARTITION_RANGE (contiguous blocks)
+    Pre-condition:
+             - g must not be NULL and its label index must be built.
+    Post-condition:
+             - Each row keeps global neighbor indices sorted by label, the order
+               BFSVisit explores them in, so sharded BFS can reproduce its order.
+             - Program exits on malloc failure.
+*/
+ShardedGraph* partitionGraph(const Graph* g, int numShards, PartitionMode mode) {
+    int n = g->numVertices;
+    ShardedGraph* sg = malloc(sizeof(ShardedGraph));
+    if (sg == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    sg->numVertices = n;
+    sg->numShards = numShards > 0 ? numShards : 1;
+    sg->mode = mode;
+    sg->rangeSize = (n + sg->numShards - 1) / sg->numShards;
+    if (sg->rangeSize == 0) {
+        sg->rangeSize = 1;
+    }
+    sg->shards = calloc(sg->numShards, sizeof(GraphShard));
+    int cap = 64;
+    KeyIndex* row = malloc(cap * sizeof(KeyIndex));
+    if (sg->shards == NULL || row == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    int s, v;
+    for (v = 0; v < n; v++) {
+        sg->shards[shardOwner(sg, v)].numLocal++;
+    }
+    for (s = 0; s < sg->numShards; s++) {
+        GraphShard* sh = &sg->shards[s];
+        int local = sh->numLocal;
+        sh->shard = s;
+        sh->globalId = malloc((local > 0 ? local : 1) * sizeof(int));
+        sh->offsets = malloc((local + 1) * sizeof(int));
+        if (sh->globalId == NULL || sh->offsets == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+        sh->offsets[0] = 0;
+    }
+
+    // first pass counts the neighbors that are vertices, second pass sorts each row once and fills it
+    for (v = 0; v < n; v++) {
+        GraphShard* sh = &sg->shards[shardOwner(sg, v)];
+        int i = shardLocalIndex(sg, v);
+        int cnt = 0;
+        for (Node* cur = g->adjList[v].head->edge; cur != NULL; cur = cur->edge) {
+            cnt += (nodeVertex(g, cur) >= 0);
+        }
+        sh->globalId[i] = v;
+        sh->offsets[i + 1] = cnt;
+    }
+    for (s = 0; s < sg->numShards; s++) {
+        GraphShard* sh = &sg->shards[s];
+        for (int i = 0; i < sh->numLocal; i++) {
+            sh->offsets[i + 1] += sh->offsets[i];
+        }
+        sh->neighbors = malloc((sh->offsets[sh->numLocal] > 0 ? sh->offsets[sh->numLocal] : 1) * sizeof(int));
+        if (sh->neighbors == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+    }
+    for (v = 0; v < n; v++) {
+        GraphShard* sh = &sg->shards[shardOwner(sg, v)];
+        int i = shardLocalIndex(sg, v);
+        int cnt = sortedNeighborRow(g, v, &row, &cap);
+        for (int k = 0; k < cnt; k++) {
+            sh->neighbors[sh->offsets[i] + k] = row[k].index;
+        }
+    }
+    free(row);
+    return sg;
+}
+
+/**
+    Purpose: Frees a ShardedGraph and all of its shards.
+    Returns: NULL
+    @param  : sg - pointer to the ShardedGraph
+    Post-condition:
+             - Returns NULL so caller can safely do: sg = freeShardedGraph(sg);
+*/
+ShardedGraph* freeShardedGraph(ShardedGraph* sg) {
+    if (sg != NULL) {
+        for (int s = 0; s < sg->numShards; s++) {
+            free(sg->shards[s].globalId);
+            free(sg->shards[s].offsets);
+            free(sg->shards[s].neighbors);
+        }
+        free(sg->shards);
+        free(sg);
+    }
+    return NULL;
+}
+
+#ifndef _WIN32
+/**
+    Purpose: Writes a whole buffer to a pipe, retrying short writes.
+    Returns: 1 if everything was written; 0 on error
+    @param  : fd  - file descriptor
+    @param  : buf - bytes to write
+    @param  : len - number of bytes
+*/
+int writeAll(int fd, const void* buf, size_t len) {
+    const char* p = buf;
+    while (len > 0) {
+        ssize_t got = write(fd, p, len);
+        if (got <= 0) {
+            return 0;
+        }
+        p += got;
+        len -= (size_t) got;
+    }
+    return 1;
+}
+
+/**
+    Purpose: Reads exactly len bytes from a pipe, retrying short reads.
+    Returns: 1 if everything was read; 0 on error or end of file
+    @param  : fd  - file descriptor
+    @param  : buf - destination
+    @param  : len - number of bytes
+*/
+int readAll(int fd, void* buf, size_t len) {
+    char* p = buf;
+    while (len > 0) {
+        ssize_t got = read(fd, p, len);
+        if (got <= 0) {
+            return 0;
+        }
+        p += got;
+        len -= (size_t) got;
+    }
+    return 1;
+}
+
+/**
+    Purpose: Sends one shard message: an opcode and a list of entries.
+    Returns: void
+    @param  : fd      - pipe to write to
+    @param  : op      - ShardOp
+    @param  : entries - entries to send
+    @param  : count   - number of entries
+    Post-condition:
+             - Program exits if the pipe breaks.
+*/
+void sendShardMessage(int fd, int op, const FrontierEntry* entries, int count) {
+    int header[2] = { op, count };
+    if (!writeAll(fd, header, sizeof(header)) ||
+        !writeAll(fd, entries, (size_t) count * sizeof(FrontierEntry))) {
+        fprintf(stderr, "Error: SHARD PIPE WRITE FAILED!\n");
+        exit(1);
+    }
+}
+
+/**
+    Purpose: Receives one shard message into a growable buffer.
+    Returns: Number of entries received
+    @param  : fd  - pipe to read from
+    @param  : op  - receives the ShardOp
+    @param  : buf - address of a malloc'd entry buffer (may be reallocated)
+    @param  : cap - address of the buffer's capacity
+    Post-condition:
+             - Program exits if the pipe breaks.
+*/
+int recvShardMessage(int fd, int* op, FrontierEntry** buf, int* cap) {
+    int header[2];
+    if (!readAll(fd, header, sizeof(header))) {
+        fprintf(stderr, "Error: SHARD PIPE READ FAILED!\n");
+        exit(1);
+    }
+    *op = header[0];
+    if (header[1] > *cap) {
+        *cap = header[1];
+        *buf = realloc(*buf, *cap * sizeof(FrontierEntry));
+        if (*buf == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
+        }
+    }
+    if (!readAll(fd, *buf, (size_t) header[1] * sizeof(FrontierEntry))) {
+        fprintf(stderr, "Error: SHARD PIPE READ FAILED!\n");
+        exit(1);
+    }
+    return header[1];
+}
+
+/**
+    Purpose: Serves requests for one shard until told to stop (runs in the worker process).
+    Returns: void
+    @param  : sg  - pointer to the ShardedGraph (only this shard's rows are read)
+    @param  : sh  - the shard this worker owns
+    @param  : in  - pipe carrying requests from the coordinator
+    @param  : out - pipe carrying replies to the coordinator
+    Post-condition:
+             - Every request gets exactly one reply, after the whole request has
+               been read, so the coordinator can send to all workers before
+               reading any reply without deadlocking.
+*/
+void shardWorkerLoop(const ShardedGraph* sg, const GraphShard* sh, int in, int out) {
+    int local = sh->numLocal;
+    char* visited = calloc(local > 0 ? local : 1, 1);
+    char* changed = calloc(local > 0 ? local : 1, 1);
+    int* label = malloc((local > 0 ? local : 1) * sizeof(int));
+    FrontierEntry* best = malloc((local > 0 ? local : 1) * sizeof(FrontierEntry));
+    int inCap = 64, outCap = 64;
+    FrontierEntry* inBuf = malloc(inCap * sizeof(FrontierEntry));
+    FrontierEntry* outBuf = malloc(outCap * sizeof(FrontierEntry));
+    if (visited == NULL || changed == NULL || label == NULL || best == NULL ||
+        inBuf == NULL || outBuf == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+
+    int op = SHARD_RESET;
+    while (op != SHARD_STOP) {
+        int count = recvShardMessage(in, &op, &inBuf, &inCap);
+        int outCount = 0, i, k;
+
+        // every reply is at most one entry per local edge (or vertex)
+        int need = (op == SHARD_EXPAND || op == SHARD_SPREAD) ? sh->offsets[local] : local;
+        if (need > outCap) {
+            outCap = need;
+            outBuf = realloc(outBuf, outCap * sizeof(FrontierEntry));
+            if (outBuf == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+        }
+
+        if (op == SHARD_RESET) {
+            // fresh traversal: nothing visited, every vertex its own component
+            for (i = 0; i < local; i++) {
+                visited[i] = 0;
+                changed[i] = 1;
+                label[i] = sh->globalId[i];
+                best[i].vertex = -1;
+            }
+        } else if (op == SHARD_EXPAND) {
+            // (u, pos) -> (w, pos, k) for the k-th label-sorted neighbor w of u
+            for (i = 0; i < count; i++) {
+                int u = shardLocalIndex(sg, inBuf[i].vertex);
+                visited[u] = 1;
+                for (k = sh->offsets[u]; k < sh->offsets[u + 1]; k++) {
+                    outBuf[outCount].vertex = sh->neighbors[k];
+                    outBuf[outCount].pos = inBuf[i].pos;
+                    outBuf[outCount].rank = k - sh->offsets[u];
+                    outCount++;
+                }
+            }
+        } else if (op == SHARD_ACCEPT) {
+            // keep the earliest (pos, rank) discovery of each unvisited vertex
+            for (i = 0; i < count; i++) {
+                int w = shardLocalIndex(sg, inBuf[i].vertex);
+                if (!visited[w]) {
+                    if (best[w].vertex < 0) {
+                        best[w] = inBuf[i];
+                        outBuf[outCount].vertex = w;   // local index, fixed below
+                        outCount++;
+                    } else if (inBuf[i].pos < best[w].pos ||
+                               (inBuf[i].pos == best[w].pos && inBuf[i].rank < best[w].rank)) {
+                        best[w] = inBuf[i];
+                    }
+                }
+            }
+            for (i = 0; i < outCount; i++) {
+                int w = outBuf[i].vertex;
+                outBuf[i] = best[w];
+                visited[w] = 1;
+                best[w].vertex = -1;
+            }
+        } else if (op == SHARD_SPREAD) {
+            // send the label of every vertex that changed to all its neighbors
+            for (i = 0; i < local; i++) {
+                if (changed[i]) {
+                    for (k = sh->offsets[i]; k < sh->offsets[i + 1]; k++) {
+                        outBuf[outCount].vertex = sh->neighbors[k];
+                        outBuf[outCount].pos = label[i];
+                        outBuf[outCount].rank = 0;
+                        outCount++;
+                    }
+                    changed[i] = 0;
+                }
+            }
+        } else if (op == SHARD_RELAX) {
+            // take the smallest label offered; reply with how many changed
+            for (i = 0; i < count; i++) {
+                int w = shardLocalIndex(sg, inBuf[i].vertex);
+                if (inBuf[i].pos < label[w]) {
+                    label[w] = inBuf[i].pos;
+                    if (!changed[w]) {
+                        changed[w] = 1;
+                        outCount++;
+                    }
+                }
+            }
+            outBuf[0].vertex = outCount;
+            outCount = 1;
+        } else if (op == SHARD_COLLECT) {
+            for (i = 0; i < local; i++) {
+                outBuf[i].vertex = sh->globalId[i];
+                outBuf[i].pos = label[i];
+                outBuf[i].rank = 0;
+            }
+            outCount = local;
+        }
+        if (op != SHARD_STOP) {
+            sendShardMessage(out, op, outBuf, outCount);
+        }
+    }
+
+    free(visited);
+    free(changed);
+    free(label);
+    free(best);
+    free(inBuf);
+    free(outBuf);
+}
+
+/**
+    Purpose: Starts one worker process per shard, connected by a pair of pipes.
+    Returns: 1 if every worker started; 0 otherwise (workers already started are stopped)
+    @param  : sg      - pointer to the ShardedGraph
+    @param  : workers - array of sg->numShards ShardWorker, filled in
+    Pre-condition:
+             - Call before the process runs its first OpenMP parallel region (the
+               parallel loader, triangles, PageRank, ...). fork copies only the
+               calling thread, and an OpenMP runtime whose pool threads already
+               exist is not guaranteed to be usable, or even safe, in the child.
+    Post-condition:
+             - Each worker is a fork of the caller that serves shardWorkerLoop for
+               its shard and then exits; the workers themselves use no OpenMP.
+             - Returns 0 without forking when called inside a parallel region.
+*/
+int startShardWorkers(const ShardedGraph* sg, ShardWorker workers[]) {
+#ifdef _OPENMP
+    if (omp_in_parallel()) {
+        return 0;
+    }
+#endif
+    fflush(NULL);   // do not let children flush the parent's buffered output
+    for (int s = 0; s < sg->numShards; s++) {
+        int toWorker[2], fromWorker[2];
+        if (pipe(toWorker) != 0) {
+            stopShardWorkers(s, workers);
+            return 0;
+        }
+        if (pipe(fromWorker) != 0) {
+            close(toWorker[0]);
+            close(toWorker[1]);
+            stopShardWorkers(s, workers);
+            return 0;
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(toWorker[0]);
+            close(toWorker[1]);
+            close(fromWorker[0]);
+            close(fromWorker[1]);
+            stopShardWorkers(s, workers);
+            return 0;
+        }
+        if (pid == 0) {
+            // worker: drop the coordinator's ends, including earlier workers' pipes
+            for (int t = 0; t < s; t++) {
+                close(workers[t].toWorker);
+                close(workers[t].fromWorker);
+            }
+            close(toWorker[1]);
+            close(fromWorker[0]);
+            shardWorkerLoop(sg, &sg->shards[s], toWorker[0], fromWorker[1]);
+            _exit(0);
+        }
+        close(toWorker[0]);
+        close(fromWorker[1]);
+        workers[s].pid = pid;
+        workers[s].toWorker = toWorker[1];
+        workers[s].fromWorker = fromWorker[0];
+    }
+    return 1;
+}
+
+/**
+    Purpose: Stops worker processes and waits for them to exit.
+    Returns: void
+    @param  : numWorkers - number of workers in the array
+    @param  : workers    - workers started by startShardWorkers
+*/
+void stopShardWorkers(int numWorkers, ShardWorker workers[]) {
+    for (int s = 0; s < numWorkers; s++) {
+        sendShardMessage(workers[s].toWorker, SHARD_STOP, NULL, 0);
+        close(workers[s].toWorker);
+        close(workers[s].fromWorker);
+        waitpid(workers[s].pid, NULL, 0);
+    }
+}
+
+/**
+    Purpose: qsort comparator ordering frontier entries by (pos, rank).
+    Returns: <0, 0 or >0
+    @param  : a - pointer to the first FrontierEntry
+    @param  : b - pointer to the second FrontierEntry
+*/
+int compareFrontierEntry(const void* a, const void* b) {
+    const FrontierEntry* x = a;
+    const FrontierEntry* y = b;
+    if (x->pos != y->pos) {
+        return (x->pos > y->pos) - (x->pos < y->pos);
+    }
+    return (x->rank > y->rank) - (x->rank < y->rank);
+}
+
+/**
+    Purpose: Sends each shard its slice of a list of entries and gathers all replies.
+    Returns: Number of entries in the combined reply
+    @param  : sg      - pointer to the ShardedGraph
+    @param  : workers - running workers
+    @param  : op      - ShardOp to send
+    @param  : entries - entries to route by the owner of entries[i].vertex; NULL sends none
+    @param  : count   - number of entries
+    @param  : reply   - address of a malloc'd buffer for the replies (may be reallocated)
+    @param  : cap     - address of the reply buffer's capacity
+    Post-condition:
+             - All requests are written before any reply is read, so the workers
+               run in parallel.
+*/
+int shardRound(const ShardedGraph* sg, ShardWorker workers[], int op,
+               const FrontierEntry* entries, int count, FrontierEntry** reply, int* cap) {
+    int numShards = sg->numShards;
+    int* slice = calloc(numShards + 1, sizeof(int));
+    FrontierEntry* routed = malloc((count > 0 ? count : 1) * sizeof(FrontierEntry));
+    if (slice == NULL || routed == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int i, s;
+
+    // counting sort by owner keeps each shard's entries in list order
+    for (i = 0; i < count; i++) {
+        slice[shardOwner(sg, entries[i].vertex) + 1]++;
+    }
+    for (s = 0; s < numShards; s++) {
+        slice[s + 1] += slice[s];
+    }
+    for (i = 0; i < count; i++) {
+        int owner = shardOwner(sg, entries[i].vertex);
+        routed[slice[owner]] = entries[i];
+        slice[owner]++;
+    }
+    for (s = numShards; s > 0; s--) {
+        slice[s] = slice[s - 1];
+    }
+    slice[0] = 0;
+
+    for (s = 0; s < numShards; s++) {
+        sendShardMessage(workers[s].toWorker, op, routed + slice[s], slice[s + 1] - slice[s]);
+    }
+
+    int total = 0, partCap = 64, replyOp;
+    FrontierEntry* part = malloc(partCap * sizeof(FrontierEntry));
+    if (part == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (s = 0; s < numShards; s++) {
+        int got = recvShardMessage(workers[s].fromWorker, &replyOp, &part, &partCap);
+        if (total + got > *cap) {
+            *cap = (total + got) * 2;
+            *reply = realloc(*reply, *cap * sizeof(FrontierEntry));
+            if (*reply == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+        }
+        memcpy(*reply + total, part, got * sizeof(FrontierEntry));
+        total += got;
     }
+
+    free(part);
+    free(slice);
+    free(routed);
+    return total;
 }
 
 /**
-    Purpose: Generates a file that represents an adjacency list of the graph (<input>-LIST.TXT).
-    Returns: void
-    @param  : g             - pointer to the Graph
-    @param  : inputFilename - name of the input file
-    Pre-condition:
-             - g must not be NULL and must contain valid graph data
-             - inputFilename must be a valid null-terminated string
+    Purpose: Level-synchronous BFS across shard worker processes.
+    Returns: Number of vertices reached
+    @param  : sg      - pointer to the ShardedGraph
+    @param  : workers - workers started by startShardWorkers
+    @param  : start   - index of the start vertex
+    @param  : order   - output; vertices in visit order (may be NULL)
+    @param  : dist    - output; hop distance from start, -1 if unreached (may be NULL)
+    Post-condition:
+             - order is exactly BFSVisit's order on the unpartitioned graph: a vertex
+               first seen as neighbor k of the frontier vertex at position p sorts
+               by (p, k), which is when the sequential queue would enqueue it.
+             - Per level: owners expand their frontier vertices into
+               (neighbor, p, k) entries, the coordinator routes them to the
+               neighbors' owners, and each owner accepts its unvisited vertices.
 */
-void ProduceListFile(const Graph* g, const char* inputFilename) {
-    char outputFilename[MAX_FILE_NAME_LEN];
-    FILE* fp = NULL;
-    int i = 0;
-    
-    // Copy input filename and remove extension
-    strcpy(outputFilename, inputFilename);
-    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
-        i++;
+int shardedBFS(const ShardedGraph* sg, ShardWorker workers[], int start, int order[], int dist[]) {
+    int n = sg->numVertices;
+    int frontierCap = 64, replyCap = 64, level = 0, reached = 0, i;
+    FrontierEntry* frontier = malloc(frontierCap * sizeof(FrontierEntry));
+    FrontierEntry* reply = malloc(replyCap * sizeof(FrontierEntry));
+    if (frontier == NULL || reply == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
     }
-    outputFilename[i] = '\0'; // Truncate at '.' or end
-    
-    // Append suffix
-    strcat(outputFilename, "-LIST.TXT");
-    
-    fp = fopen(outputFilename, "w");
+    if (dist != NULL) {
+        for (i = 0; i < n; i++) {
+            dist[i] = -1;
+        }
+    }
+    shardRound(sg, workers, SHARD_RESET, NULL, 0, &reply, &replyCap);
 
-    if (fp != NULL) 
-	{
-		for (i = 0; i < g->numVertices; i++)
-		{
-			// vertex	
-			fprintf(fp, "%s", g->adjList[i].head->vertexName);
+    int size = 1;
+    frontier[0].vertex = start;
+    frontier[0].pos = 0;
+    frontier[0].rank = 0;
+    while (size > 0) {
+        // record this level; positions are global within the level
+        for (i = 0; i < size; i++) {
+            frontier[i].pos = i;
+            if (order != NULL) {
+                order[reached + i] = frontier[i].vertex;
+            }
+            if (dist != NULL) {
+                dist[frontier[i].vertex] = level;
+            }
+        }
+        reached += size;
 
-			// edges
-			Node* neighbor = g->adjList[i].head->edge;
+        int candidates = shardRound(sg, workers, SHARD_EXPAND, frontier, size, &reply, &replyCap);
+        if (candidates > frontierCap) {
+            frontierCap = candidates;
+            frontier = realloc(frontier, frontierCap * sizeof(FrontierEntry));
+            if (frontier == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+        }
+        memcpy(frontier, reply, candidates * sizeof(FrontierEntry));
+        size = shardRound(sg, workers, SHARD_ACCEPT, frontier, candidates, &reply, &replyCap);
+        memcpy(frontier, reply, size * sizeof(FrontierEntry));
+        qsort(frontier, size, sizeof(FrontierEntry), compareFrontierEntry);
+        level++;
+    }
 
-			while (neighbor != NULL)
-			{
-				fprintf(fp, "->");
+    free(frontier);
+    free(reply);
+    return reached;
+}
 
-				fprintf(fp,"%s", neighbor->vertexName);	
+/**
+    Purpose: Labels connected components across shard worker processes.
+    Returns: Number of components
+    @param  : sg      - pointer to the ShardedGraph
+    @param  : workers - workers started by startShardWorkers
+    @param  : comp    - output; comp[v] = smallest vertex index in v's component
+    Pre-condition:
+             - The graph is undirected (each edge listed at both ends).
+    Post-condition:
+             - Same labels as labelComponents. Min-label propagation: each round
+               the vertices whose label dropped send it to their neighbors' owners,
+               until a round changes nothing.
+*/
+int shardedComponents(const ShardedGraph* sg, ShardWorker workers[], int comp[]) {
+    int replyCap = 64, msgCap = 64, i;
+    FrontierEntry* reply = malloc(replyCap * sizeof(FrontierEntry));
+    FrontierEntry* msgs = malloc(msgCap * sizeof(FrontierEntry));
+    if (reply == NULL || msgs == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    shardRound(sg, workers, SHARD_RESET, NULL, 0, &reply, &replyCap);
 
-				neighbor = neighbor->edge;			
-			}
+    int changed = 1;
+    while (changed > 0) {
+        int count = shardRound(sg, workers, SHARD_SPREAD, NULL, 0, &reply, &replyCap);
+        if (count > msgCap) {
+            msgCap = count;
+            msgs = realloc(msgs, msgCap * sizeof(FrontierEntry));
+            if (msgs == NULL) {
+                fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                exit(1);
+            }
+        }
+        memcpy(msgs, reply, count * sizeof(FrontierEntry));
+        int replies = shardRound(sg, workers, SHARD_RELAX, msgs, count, &reply, &replyCap);
+        changed = 0;
+        for (i = 0; i < replies; i++) {
+            changed += reply[i].vertex;
+        }
+    }
 
-			fprintf(fp, "->\\\n");
-		}	
+    int count = shardRound(sg, workers, SHARD_COLLECT, NULL, 0, &reply, &replyCap);
+    int components = 0;
+    for (i = 0; i < count; i++) {
+        comp[reply[i].vertex] = reply[i].pos;
+        if (reply[i].pos == reply[i].vertex) {
+            components++;
+        }
+    }
+    free(reply);
+    free(msgs);
+    return components;
+}
+#endif
 
-        fclose(fp);
+/**
+    Purpose: Initializes an empty SparseVertexMap.
+    Returns: void
+    @param  : m        - pointer to the map
+    @param  : expected - number of entries expected (the map grows past it)
+    Post-condition:
+             - Capacity is a power of two at least twice expected.
+             - Program exits on malloc failure.
+*/
+void initSparseMap(SparseVertexMap* m, int expected) {
+    m->cap = 16;
+    while (m->cap < expected * 2) {
+        m->cap *= 2;
+    }
+    m->count = 0;
+    m->keys = malloc(m->cap * sizeof(int));
+    m->values = malloc(m->cap * sizeof(int));
+    if (m->keys == NULL || m->values == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    for (int i = 0; i < m->cap; i++) {
+        m->keys[i] = -1;
     }
 }
 
 /**
-    Purpose: A helper function for ProduceMatrixFile for proper spacing
-    Returns: Maximum length of vertex names plus padding
-    @param  : g             - pointer to the Graph
-    Pre-condition:
-             - g must not be NULL and must contain valid graph data
+    Purpose: Releases a SparseVertexMap's slots.
+    Returns: void
+    @param  : m - pointer to the map
 */
+void freeSparseMap(SparseVertexMap* m) {
+    free(m->keys);
+    free(m->values);
+    m->keys = NULL;
+    m->values = NULL;
+    m->cap = 0;
+    m->count = 0;
+}
 
-int matrixHelper(const Graph* g)
-{
-    int maxNameLen = 0;
-    for (int i = 0; i < g->numVertices; i++) {
-        int currentLen = strlen(g->adjList[i].head->vertexName);
-        if (currentLen > maxNameLen) {
-            maxNameLen = currentLen;
-        }
+/**
+    Purpose: Finds the slot a vertex occupies or would occupy.
+    Returns: Slot index
+    @param  : m - pointer to the map
+    @param  : v - vertex index (>= 0)
+    Post-condition:
+             - Fibonacci hashing with linear probing.
+*/
+int sparseMapSlot(const SparseVertexMap* m, int v) {
+    int slot = (int) (((uint32_t) v * 2654435761u) & (uint32_t) (m->cap - 1));
+    while (m->keys[slot] >= 0 && m->keys[slot] != v) {
+        slot = (slot + 1) & (m->cap - 1);
     }
-    maxNameLen += 2; // Adds padding
+    return slot;
+}
 
-    return maxNameLen;
+/**
+    Purpose: Looks up a vertex.
+    Returns: Value stored for v; -1 if v is not in the map
+    @param  : m - pointer to the map
+    @param  : v - vertex index
+*/
+int sparseMapGet(const SparseVertexMap* m, int v) {
+    int slot = sparseMapSlot(m, v);
+    return m->keys[slot] == v ? m->values[slot] : -1;
 }
 
 /**
-    Purpose: Generates an adjacency matrix file (<input>-MATRIX.TXT).
+    Purpose: Stores a value for a vertex, replacing any earlier one.
     Returns: void
-    @param  : g             - pointer to the Graph
-    @param  : inputFilename - name of the input file
-    Pre-condition:
-             - g must not be NULL and must contain valid graph data
-             - inputFilename must be a valid null-terminated string
+    @param  : m     - pointer to the map
+    @param  : v     - vertex index (>= 0)
+    @param  : value - value to store
+    Post-condition:
+             - The table doubles once it is half full.
+             - Program exits on malloc failure.
 */
-void ProduceMatrixFile(const Graph* g, const char* inputFilename) {
-    char outputFilename[MAX_FILE_NAME_LEN] = {0};
-    int i = 0;
-    
-    // Process filename
-    strcpy(outputFilename, inputFilename);
-    while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
-        i++;
+void sparseMapPut(SparseVertexMap* m, int v, int value) {
+    if ((m->count + 1) * 2 > m->cap) {
+        SparseVertexMap grown;
+        initSparseMap(&grown, m->cap);
+        for (int i = 0; i < m->cap; i++) {
+            if (m->keys[i] >= 0) {
+                int slot = sparseMapSlot(&grown, m->keys[i]);
+                grown.keys[slot] = m->keys[i];
+                grown.values[slot] = m->values[i];
+            }
+        }
+        grown.count = m->count;
+        freeSparseMap(m);
+        *m = grown;
     }
-    outputFilename[i] = '\0';
-    strcat(outputFilename, "-MATRIX.TXT");
-    
-    // 2. Open file 
-    FILE* fp = fopen(outputFilename, "w");
-    
-    // Process data
-    if (fp != NULL) {
+    int slot = sparseMapSlot(m, v);
+    if (m->keys[slot] != v) {
+        m->keys[slot] = v;
+        m->count++;
+    }
+    m->values[slot] = value;
+}
 
-        int maxNameLen = matrixHelper(g);
-        
-        /* Print header row */
-        fprintf(fp, "%*s", maxNameLen, "");
-        for (i = 0; i < g->numVertices; i++) {
-            fprintf(fp, "%-*s", maxNameLen, g->adjList[i].head->vertexName);
+/**
+    Purpose: Decides whether traversal limits can keep a walk well below the whole graph.
+    Returns: 1 if a depth limit, target or visit budget under V is set; 0 otherwise
+    @param  : g   - pointer to the Graph
+    @param  : lim - traversal limits (may be NULL)
+*/
+int isBoundedTraversal(const Graph* g, const TraversalLimits* lim) {
+    return lim != NULL && (lim->maxDepth >= 0 || lim->target >= 0 ||
+                           (lim->maxVisits >= 0 && lim->maxVisits < g->numVertices));
+}
+
+/**
+    Purpose: Initializes an empty visited set.
+    Returns: void
+    @param  : s      - pointer to the set
+    @param  : n      - number of vertices in the graph
+    @param  : sparse - nonzero for a SparseVertexMap, zero for a V-sized array
+    Post-condition:
+             - A full traversal touches every reachable vertex anyway, so the array
+               costs nothing extra and avoids hashing each one; bounded queries
+               use the map so they stay proportional to what they visit.
+             - Program exits on malloc failure.
+*/
+void initVisitedSet(VisitedSet* s, int n, int sparse) {
+    if (sparse) {
+        s->dense = NULL;
+        initSparseMap(&s->sparse, 16);
+    } else {
+        s->dense = malloc((n > 0 ? n : 1) * sizeof(int));
+        if (s->dense == NULL) {
+            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+            exit(1);
         }
-        fprintf(fp, "\n");
-        
-        /* Print matrix rows */
-        for (i = 0; i < g->numVertices; i++) {
-            fprintf(fp, "%-*s", maxNameLen, g->adjList[i].head->vertexName);
-            
-            for (int j = 0; j < g->numVertices; j++) {
-                int connected = 0;
-                Node* neighbor = g->adjList[i].head->edge;
-                int neighborExists = (neighbor != NULL);
-                
-                /* Check connection */
-                while (neighborExists) {
-                    if (strcmp(neighbor->vertexName, g->adjList[j].head->vertexName) == 0) {
-                        connected = 1;
-                    }
-                    neighbor = neighbor->edge;
-                    neighborExists = (neighbor != NULL);
-                }
-                fprintf(fp, "%-*d", maxNameLen, connected);
-            }
-            fprintf(fp, "\n");
+        for (int v = 0; v < n; v++) {
+            s->dense[v] = -1;
         }
-        fclose(fp);
     }
 }
 
 /**
-    Purpose: Generates a BFS traversal file (<input filename>-BFS.TXT).
+    Purpose: Releases a visited set.
     Returns: void
-    @param  : g             - pointer to the Graph
-    @param  : inputFilename - name of the input file
-    @param  : startVertex   - name of the starting vertex
-
-    Pre-condition:
-             - g must not be NULL and must contain valid graph data
-             - startVertex must exist in the graph
-             - inputFilename must be a valid null-terminated string
+    @param  : s - pointer to the set
 */
-void ProduceBFSFile(const Graph* g, const char* inputFilename, const strName startVertex) {
-    char outputFilename[MAX_FILE_NAME_LEN];
-    FILE* fp = NULL;
-    int vertexExists = 0;   // Flag to check if vertex exists
-    
-    // If there exists at least one vertex inside the set 
-    for (int i = 0; i < g->numVertices; i++) 
-	{
-        if (strcmp(g->adjList[i].head->vertexName, startVertex) == 0) {
-            vertexExists = 1;
-        }
+void freeVisitedSet(VisitedSet* s) {
+    if (s->dense != NULL) {
+        free(s->dense);
+        s->dense = NULL;
+    } else {
+        freeSparseMap(&s->sparse);
     }
-    
-    if (vertexExists) 
-	{
-		// Copy input filename and remove extension
-        strcpy(outputFilename, inputFilename);
+}
 
-		int i;
-        for (i = 0; outputFilename[i] != '\0' && outputFilename[i] != '.'; i++);
+/**
+    Purpose: Looks up a vertex in a visited set.
+    Returns: Value stored for v; -1 if v has not been visited
+    @param  : s - pointer to the set
+    @param  : v - vertex index
+*/
+int visitedGet(const VisitedSet* s, int v) {
+    return (s->dense != NULL) ? s->dense[v] : sparseMapGet(&s->sparse, v);
+}
 
-        outputFilename[i] = '\0';
+/**
+    Purpose: Marks a vertex visited with a value (e.g. its depth).
+    Returns: void
+    @param  : s     - pointer to the set
+    @param  : v     - vertex index
+    @param  : value - value to store (>= 0)
+*/
+void visitedPut(VisitedSet* s, int v, int value) {
+    if (s->dense != NULL) {
+        s->dense[v] = value;
+    } else {
+        sparseMapPut(&s->sparse, v, value);
+    }
+}
 
-        // Append suffix
-        strcat(outputFilename, "-BFS.TXT");
+/**
+    Purpose: Extracts the subgraph induced by the vertices within k hops of a vertex.
+    Returns: Pointer to the new Graph
+    @param  : g      - pointer to the Graph
+    @param  : center - index of the center vertex
+    @param  : hops   - k; 0 yields the center alone
+    Pre-condition:
+             - g must not be NULL and its label index must be built.
+    Post-condition:
+             - Vertices are in BFS discovery order, center first; each row keeps
+               the original row's order, minus neighbors outside the subgraph.
+             - Membership lives in a SparseVertexMap rather than V-sized arrays,
+               so the work is proportional to the rows of the extracted vertices.
+             - Program exits on malloc failure.
+*/
+Graph* extractEgoNetwork(const Graph* g, int center, int hops) {
+    SparseVertexMap member;   // vertex -> position in the subgraph
+    int cap = 16, count = 0, i;
+    int* vertices = malloc(cap * sizeof(int));
+    int* depth = malloc(cap * sizeof(int));
+    if (vertices == NULL || depth == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    initSparseMap(&member, cap);
 
-        fp = fopen(outputFilename, "w");
-        if (fp != NULL) 
-		{
-            strName traversal[g->numVertices];
-            int vertexCount = BFS(g, startVertex, traversal);
+    // 1) BFS out to k hops; the vertex list doubles as the queue
+    sparseMapPut(&member, center, 0);
+    vertices[0] = center;
+    depth[0] = 0;
+    count = 1;
+    for (i = 0; i < count; i++) {
+        if (depth[i] < hops) {
+            for (Node* cur = g->adjList[vertices[i]].head->edge; cur != NULL; cur = cur->edge) {
+                int w = nodeVertex(g, cur);
+                if (w >= 0 && sparseMapGet(&member, w) < 0) {
+                    if (count == cap) {
+                        cap *= 2;
+                        vertices = realloc(vertices, cap * sizeof(int));
+                        depth = realloc(depth, cap * sizeof(int));
+                        if (vertices == NULL || depth == NULL) {
+                            fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+                            exit(1);
+                        }
+                    }
+                    sparseMapPut(&member, w, count);
+                    vertices[count] = w;
+                    depth[count] = depth[i] + 1;
+                    count++;
+                }
+            }
+        }
+    }
 
-            for (i = 0; i < vertexCount; i++) 
-			{
-                fprintf(fp, "%s", traversal[i]);
+    // 2) Copy the labels of the members into the new graph's arena
+    Graph* ego = createGraph(count);
+    if (ego == NULL) {
+        fprintf(stderr, "Error: MEMORY ALLOCATION FAILED!\n");
+        exit(1);
+    }
+    int* egoLabel = depth;   // depths are no longer needed
+    for (i = 0; i < count; i++) {
+        int label = g->adjList[vertices[i]].head->label;
+        egoLabel[i] = internLabel(ego->labels, labelText(g->labels, label), g->labels->refs[label].length);
+        appendNode(&ego->adjList[i], egoLabel[i]);
+    }
 
-                if (i < vertexCount - 1) 
-                    fprintf(fp, " ");
+    // 3) Keep only the edges between members
+    for (i = 0; i < count; i++) {
+        for (Node* cur = g->adjList[vertices[i]].head->edge; cur != NULL; cur = cur->edge) {
+            int w = nodeVertex(g, cur);
+            int pos = w >= 0 ? sparseMapGet(&member, w) : -1;
+            if (pos >= 0) {
+                appendNode(&ego->adjList[i], egoLabel[pos]);
             }
+        }
+    }
+    buildLabelIndex(ego);
 
-            fclose(fp);
+    freeSparseMap(&member);
+    free(vertices);
+    free(depth);
+    return ego;
+}
+
+/**
+    Purpose: Writes a graph in the format ReadInputFile reads.
+    Returns: 1 if the file was written; 0 if it could not be opened
+    @param  : g        - pointer to the Graph
+    @param  : fileName - name of the file to create
+    Post-condition:
+             - One line per vertex, in input-file order: label, neighbors, "-1".
+*/
+int WriteInputFile(const Graph* g, const char* fileName) {
+    FILE* fp = fopen(fileName, "w");
+    if (fp == NULL) {
+        return 0;
+    }
+    fprintf(fp, "%d\n", g->numVertices);
+    for (int pos = 0; pos < g->numVertices; pos++) {
+        Node* cur = g->adjList[vertexAtInputPos(g, pos)].head;
+        fprintf(fp, "%s", labelText(g->labels, cur->label));
+        for (cur = cur->edge; cur != NULL; cur = cur->edge) {
+            fprintf(fp, " %s", labelText(g->labels, cur->label));
         }
+        fprintf(fp, " -1\n");
     }
+    fclose(fp);
+    return 1;
 }
 
 /**
-    Purpose: Generates a DFS traversal file (<input>-DFS.TXT).
+    Purpose: Generates an ego-network file (<input filename>-EGO.TXT).
     Returns: void
     @param  : g             - pointer to the Graph
     @param  : inputFilename - name of the input file
-    @param  : startVertex   - name of the starting vertex
+    @param  : startVertex   - name of the center vertex
+    @param  : hops          - radius of the neighborhood
     Pre-condition:
              - g must not be NULL and must contain valid graph data
              - startVertex must exist in the graph
-             - inputFilename must be a valid null-terminated string
+    Post-condition:
+             - The file holds the induced k-hop subgraph in ReadInputFile's
+               format, so it can be loaded (or converted with
+               ConvertInputToGraphFile) like any other input.
 */
-void ProduceDFSFile(const Graph* g, const char* inputFilename, const strName startVertex) {
-    char outputFilename[MAX_FILE_NAME_LEN];
-    int i = 0;
-    int vertexExists = 0;   // Flag to check if vertex exists
-    
-    // Check if vertex exists (without early break)
-    for (i = 0; i < g->numVertices; i++) {
-        if (strcmp(g->adjList[i].head->vertexName, startVertex) == 0) {
-            vertexExists = 1;
-        }
-    }
-    
-    if (vertexExists) {
-        // Copy input filename and remove extension 
+void ProduceEgoFile(const Graph* g, const char* inputFilename, const char* startVertex, int hops) {
+    char outputFilename[MAX_FILE_NAME_LEN + 16];
+    int start = getVertexIndex(g, startVertex);   // -1 if vertex does not exist
+
+    if (start >= 0) {
+        // Copy input filename and remove extension
         strcpy(outputFilename, inputFilename);
-        i = 0;
-        while (outputFilename[i] != '\0' && outputFilename[i] != '.') {
-            i++;
-        }
-        outputFilename[i] = '\0'; // Truncate at '.' or end
-        
+
+        int i;
+        for (i = 0; outputFilename[i] != '\0' && outputFilename[i] != '.'; i++);
+
+        outputFilename[i] = '\0';
+
         // Append suffix
-        strcat(outputFilename, "-DFS.TXT");
-        
-        FILE* fp = fopen(outputFilename, "w");
-        if (fp != NULL) {
-            strName traversal[g->numVertices];
-            int vertexCount = DFS(g, startVertex, traversal);
-            for (i = 0; i < vertexCount; i++) {
-                fprintf(fp, "%s", traversal[i]);
-                if (i < vertexCount - 1) {
-                    fprintf(fp, " ");
-                }
-            }
-            fclose(fp);
-        }
+        strcat(outputFilename, "-EGO.TXT");
+
+        Graph* ego = extractEgoNetwork(g, start, hops);
+        WriteInputFile(ego, outputFilename);
+        ego = freeGraph(ego);
     }
 }
@@ -8,17 +8,91 @@ GROUP NUMBER : 45
 #ifndef GRAPH_H_
 #define GRAPH_H_
 
+/* fseeko, off_t and fork are POSIX; ask for them (and a 64-bit off_t) before
+   any system header, so strict -std=c11 builds see the declarations too. */
+#ifndef _WIN32
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#define MAX_LABEL_LEN (9)
+#include <stdint.h>
+#include <limits.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdatomic.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <sys/wait.h>
+#include <pthread.h>
+#endif
+#define MAX_LABEL_LEN (256)            // buffer for a label typed at the prompt; file labels are unbounded
 #define MAX_FILE_NAME_LEN (24)
+#define BETWEENNESS_EXACT_MAX (4096)   // larger graphs get sampled betweenness
+#define BETWEENNESS_SAMPLES (256)      // sources used when sampling
+#define ECCENTRICITY_EXACT_MAX (4096)  // larger graphs only get diameter/radius
+#define COMPRESSED_GROUP (64)          // vertices sharing one 64-bit block base
+#define EGO_HOPS (1)                   // default radius of the EGO report
+#define OOC_PAGE_SIZE (65536)          // bytes per on-disk adjacency page
+#define OOC_MAGIC "CCDSOOC3"           // first 8 bytes of an on-disk graph file
+#define OOC_CACHE_PAGES (64)           // pages main keeps cached for --out-of-core
+
+/* 64-bit file positioning for on-disk graphs */
+#if defined(_WIN32)
+#define graphSeek(fp, off, whence) _fseeki64(fp, (long long) (off), whence)
+#define graphTell(fp) ((long long) _ftelli64(fp))
+#else
+#define graphSeek(fp, off, whence) fseeko(fp, (off_t) (off), whence)
+#define graphTell(fp) ((long long) ftello(fp))
+#endif
 
 typedef char strName[MAX_LABEL_LEN];  // type for vertex names
 typedef char strFile[MAX_FILE_NAME_LEN];
+typedef uint64_t LabelKey;            // sort key of a label: its rank in strcmp order (see rankLabels)
+
+/* Where one label's text lives in a LabelArena. */
+typedef struct _LabelRef {
+    size_t offset;        // start of the null-terminated text in chars
+    uint32_t length;
+    uint32_t hash;        // hashLabel of the text
+} LabelRef;
+
+/* Every distinct label of a graph, stored once. Nodes refer to labels by
+   id (index into refs); equal labels always get the same id. */
+typedef struct _LabelArena {
+    char* chars;          // all label texts, back to back
+    size_t used, cap;
+    LabelRef* refs;
+    int count, refCap;
+    int* table;           // open-addressing hash of ids, -1 = empty slot
+    int tableSize;        // power of two, kept at most half full
+    LabelKey* rank;       // id -> position in strcmp order; NULL until rankLabels
+} LabelArena;
+
+/* Entry sorted by rankLabels: the 8-byte prefix settles most compares. */
+typedef struct _LabelSort {
+    LabelKey prefix;
+    const char* text;
+    int id;
+} LabelSort;
 
 typedef struct _Node {
-    strName vertexName;
+    int label;            // label id in the graph's LabelArena
     struct _Node* edge;
 } Node;
 
@@ -30,26 +104,337 @@ typedef struct _List {
 typedef struct _Graph {
     int numVertices;      // number of vertices in the graph
     List* adjList;       // array of Lists
+    int* inputOrder;      // input line -> vertex index; NULL if never reordered
+    LabelArena* labels;   // text of every vertex and neighbor label
+    int* labelVertex;     // label id -> vertex index, -1 if not a vertex; NULL if not built
 } Graph;
 
+/* Index (CSR) form of the adjacency lists: the neighbors of vertex v are
+   neighbors[offsets[v] .. offsets[v+1]-1]. */
+typedef struct _GraphCSR {
+    int numVertices;
+    int numEdges;         // number of adjacency entries (2x edges if undirected)
+    int* offsets;         // numVertices + 1 entries
+    int* neighbors;       // numEdges entries
+} GraphCSR;
+
+typedef struct _KeyIndex {
+    LabelKey key;
+    int index;
+} KeyIndex;
+
+/* V x V adjacency bits; row u starts at bits[u * wordsPerRow] and bit v of
+   the row is word v / 64, bit v % 64. */
+typedef struct _BitMatrix {
+    int numVertices;
+    int wordsPerRow;      // ceil(numVertices / 64)
+    uint64_t* bits;
+    int uniqueLabels;     // no two vertices share a label
+} BitMatrix;
+
+typedef enum _ReorderMode {
+    REORDER_DEGREE,       // descending degree, hubs first
+    REORDER_RCM           // reverse Cuthill-McKee (BFS-based bandwidth reduction)
+} ReorderMode;
+
 typedef struct _VertexDegree{
-    char name[MAX_LABEL_LEN];
+    const char* name;
+    LabelKey key;
     int degree;
 } VertexDegree;
 
+typedef struct _PageRankParams {
+    double damping;       // probability of following an edge (usually 0.85)
+    double tolerance;     // stop once the L1 change of a sweep is below this
+    int maxIterations;    // hard cap on sweeps
+} PageRankParams;
+
+/* A vertex with a real-valued score, for ranked reports. */
+typedef struct _VertexScore {
+    int index;
+    LabelKey key;
+    double score;
+} VertexScore;
+
+/* Per-source scratch space for Brandes' betweenness algorithm. */
+typedef struct _BrandesWorkspace {
+    int* dist;            // BFS distance from the source, -1 = unreached
+    int* order;           // BFS queue, replayed backwards as the stack
+    double* sigma;        // number of shortest paths from the source
+    double* delta;        // dependency of the source on each vertex
+} BrandesWorkspace;
+
+/* Scratch space for repeated BFS runs; see bfsDistances. */
+typedef struct _BFSWorkspace {
+    int* dist;            // hop distance from the last source, -1 = unreached
+    int* queue;           // vertices reached by the last run, in BFS order
+    int reached;          // number of valid entries in queue
+} BFSWorkspace;
+
+typedef struct _DiameterResult {
+    int diameter;         // largest eccentricity
+    int radius;           // smallest eccentricity
+    int size;             // number of vertices the result covers
+} DiameterResult;
+
+/* Delta + varint adjacency: the block of v starts at
+   data[groupBase[v / COMPRESSED_GROUP] + offsets[v]] and holds the degree,
+   then the sorted neighbors as gaps (see compressCSR). */
+typedef struct _CompressedGraph {
+    int numVertices;
+    int numEdges;
+    size_t dataSize;      // bytes used in data
+    size_t* groupBase;    // byte offset of every COMPRESSED_GROUP-th block
+    uint32_t* offsets;    // numVertices + 1 offsets relative to their group base
+    unsigned char* data;
+} CompressedGraph;
+
+/* A graph read straight into compressed form (see ReadCompressedInputFile):
+   vertex i is the i-th vertex in label order, and no adjacency lists exist. */
+typedef struct _CompressedInput {
+    CompressedGraph* graph;
+    LabelArena* labels;   // vertex labels only
+    int* labelOf;         // vertex -> label id
+    int* vertexOf;        // label id -> vertex; the first input line wins for shared labels
+    int* listDegree;      // entries on the vertex's input line, as DEGREE counts them
+} CompressedInput;
+
+/* Position inside one compressed neighbor block. */
+typedef struct _NeighborCursor {
+    const unsigned char* p;
+    int remaining;        // neighbors left to decode
+    int last;             // previously decoded neighbor (starts at the vertex)
+    int first;            // next code is the zigzag delta from the vertex
+} NeighborCursor;
+
+/* Graph whose adjacency data stays on disk (see ConvertInputToGraphFile);
+   only labels, offsets and a clock-managed page cache live in memory. */
+typedef struct _OOCGraph {
+    FILE* fp;
+    int numVertices;
+    int numNames;         // vertices, then neighbor labels that are not vertices
+    uint64_t numEdges;    // adjacency entries, dangling ones included
+    uint64_t dataSize;    // bytes of adjacency data
+    uint64_t dataStart;   // file offset of the adjacency data
+    LabelArena* labels;   // label texts, loaded from the file
+    int* labelOf;         // name id -> label id
+    int* vertexOf;        // label id -> vertex, -1 for a dangling neighbor label
+    uint64_t* offsets;    // numVertices + 1 block offsets into the data
+    unsigned char* cache; // numSlots pages of OOC_PAGE_SIZE bytes
+    long long* slotPage;  // page held by each slot, -1 = empty
+    unsigned char* slotRef; // clock reference bits
+    int* pageSlot;        // slot holding each page, -1 = not cached
+    long long numPages;
+    int numSlots;
+    int hand;             // clock hand
+    long long hits, misses;
+} OOCGraph;
+
+typedef int (*OOCVisitor)(const OOCGraph* g, int vIndex, int depth, void* ctx);
+
+/* One level of an iterative DFS: its unexplored neighbors are
+   pending[next .. end-1] on a shared stack. */
+typedef struct _DFSFrame {
+    int begin, next, end;
+} DFSFrame;
+
+/* A graph version waiting until no reader can still hold it */
+typedef struct _RetiredGraph {
+    Graph* graph;
+    uint64_t epoch;       // store epoch when it was replaced
+} RetiredGraph;
+
+#define EPOCH_IDLE UINT64_MAX   // reader slot holds no snapshot
+
+/* Published graph versions with epoch-based reclamation: readers pin the
+   current version without locks, a writer swaps in a new one and old
+   versions are freed once every reader has moved past them. */
+typedef struct _GraphStore {
+    _Atomic(Graph*) current;
+    _Atomic uint64_t epoch;
+    _Atomic uint64_t* readerEpoch;  // epoch announced per reader, EPOCH_IDLE if none
+    int maxReaders;
+#ifdef _WIN32
+    SRWLOCK writer;                 // held by publishGraph and reclaimSnapshots
+#else
+    pthread_mutex_t writer;         // held by publishGraph and reclaimSnapshots
+#endif
+    RetiredGraph* retired;          // guarded by writer
+    int numRetired;
+    int retiredCap;
+} GraphStore;
+
+/* How partitionGraph assigns vertices to shards. */
+typedef enum _PartitionMode {
+    PARTITION_HASH,    // vertex v goes to shard v mod N
+    PARTITION_RANGE    // contiguous blocks of ceil(V / N) vertices
+} PartitionMode;
+
+/* The rows of the vertices one shard owns. */
+typedef struct _GraphShard {
+    int shard;
+    int numLocal;      // vertices owned by this shard
+    int* globalId;     // local index -> vertex index
+    int* offsets;      // numLocal + 1
+    int* neighbors;    // global vertex indices, each row sorted by label
+} GraphShard;
+
+/* A graph split by vertex; see partitionGraph. */
+typedef struct _ShardedGraph {
+    int numVertices;
+    int numShards;
+    PartitionMode mode;
+    int rangeSize;     // vertices per shard under PARTITION_RANGE
+    GraphShard* shards;
+} ShardedGraph;
+
+/* Message entry exchanged with shard workers. For BFS: a vertex found as
+   neighbor `rank` of the frontier vertex at position `pos`. For components:
+   a vertex and the label `pos` offered to it. */
+typedef struct _FrontierEntry {
+    int vertex;
+    int pos;
+    int rank;
+} FrontierEntry;
+
+/* Requests understood by shardWorkerLoop. */
+typedef enum _ShardOp {
+    SHARD_RESET,       // clear visited marks and component labels
+    SHARD_EXPAND,      // frontier vertices -> their neighbors
+    SHARD_ACCEPT,      // candidate vertices -> the ones newly visited
+    SHARD_SPREAD,      // labels of changed vertices -> their neighbors
+    SHARD_RELAX,       // offered labels -> number of vertices that changed
+    SHARD_COLLECT,     // -> (vertex, label) for every owned vertex
+    SHARD_STOP
+} ShardOp;
+
+#ifndef _WIN32
+/* Coordinator's handle on one worker process. */
+typedef struct _ShardWorker {
+    pid_t pid;
+    int toWorker;      // write end of the request pipe
+    int fromWorker;    // read end of the reply pipe
+} ShardWorker;
+#endif
+
+/* Open-addressing map from vertex index to an int, sized by what it holds
+   rather than by the graph; see extractEgoNetwork. */
+typedef struct _SparseVertexMap {
+    int* keys;         // vertex index, -1 for an empty slot
+    int* values;
+    int cap;           // power of two
+    int count;
+} SparseVertexMap;
+
+/* Visited set of one traversal: a V-sized array when the whole component is
+   walked, a SparseVertexMap when limits keep the walk small. */
+typedef struct _VisitedSet {
+    int* dense;        // vertex -> value, -1 = unseen; NULL when sparse is used
+    SparseVertexMap sparse;
+} VisitedSet;
+
+/* One slice of the input file and the records parsed out of it. */
+typedef struct _ParseChunk {
+    size_t begin, end;    // byte range in the file buffer
+    int numRecords;       // vertex lines in this chunk
+    int numLabels;        // labels in this chunk (vertices + neighbors)
+    size_t* labelStart;   // every label as a span of the file buffer, in file order
+    int* labelLen;
+    int* labelId;         // label id once interned
+    int* lineLen;         // labels per record
+} ParseChunk;
+
+/* Callback invoked by the streaming traversals for every visited vertex,
+   in visit order. Returning nonzero stops the traversal early. */
+typedef int (*VertexVisitor)(const Graph* g, int vIndex, int depth, void* ctx);
+
+/* Why a (bounded) traversal ended. */
+typedef enum _TraversalStop {
+    TRAV_EXHAUSTED,      // every reachable vertex was visited
+    TRAV_TARGET_FOUND,   // the target vertex was visited
+    TRAV_DEPTH_LIMIT,    // reachable vertices beyond maxDepth were left out
+    TRAV_BUDGET,         // maxVisits vertices were visited
+    TRAV_VISITOR         // the visitor callback asked to stop
+} TraversalStop;
+
+/* Early-termination conditions for BFSBounded/DFSBounded; -1 disables one. */
+typedef struct _TraversalLimits {
+    int maxDepth;         // do not go further than this many hops from start
+    int target;           // stop as soon as this vertex index is visited
+    int maxVisits;        // stop after visiting this many vertices (0 visits none)
+} TraversalLimits;
+
+typedef struct _TraversalCollector {
+    const char** traversal; // destination array, sized >= numVertices
+    int count;            // number of labels stored so far
+} TraversalCollector;
+
+typedef struct _TraversalWriter {
+    FILE* fp;             // output stream
+    int count;            // number of labels written so far
+} TraversalWriter;
+
 int ReadInputFile(strFile, Graph**);
-Node* createNode(strName);
+size_t nextRecordStart(const char*, size_t, size_t);
+void parseChunk(const char*, ParseChunk*);
+int ReadInputFileParallel(strFile, Graph**, int);
+void radixSortEdges(uint64_t[], uint64_t[], size_t);
+int ReadEdgeListFile(strFile, Graph**, int);
+int readToken(FILE*, char**, size_t*);
+uint32_t hashLabel(const char*, size_t);
+LabelArena* createLabelArena(int);
+LabelArena* freeLabelArena(LabelArena*);
+LabelArena* cloneLabelArena(const LabelArena*);
+int findLabel(const LabelArena*, const char*, size_t);
+int internLabel(LabelArena*, const char*, size_t);
+const char* labelText(const LabelArena*, int);
+int compareLabelSort(const void*, const void*);
+void rankLabels(LabelArena*);
+Node* createNode(int);
 void initList(List*);
-void appendNode(List* , strName);
+void appendNode(List* , int);
 void freeList(List*);
 Graph* createGraph(int);
-void addEdge(Graph*, strName, strName);
+void addEdge(Graph*, const char*, const char*);
 Graph* freeGraph(Graph*);
-int getVertexIndex(const Graph*, const strName);
+int getVertexIndex(const Graph*, const char*);
+const char* vertexLabel(const Graph*, int);
+LabelKey vertexKey(const Graph*, int);
+int nodeVertex(const Graph*, const Node*);
 int getSortedNeighbors(const Graph*, int, int[]);
-void DFSHelper(const Graph*, int, int[], strName[], int*);
-int DFS(const Graph*, const strName, strName[]);
-int BFS(const Graph*, const strName, strName[]);
+int sortedNeighborRow(const Graph*, int, KeyIndex**, int*);
+int vertexAtInputPos(const Graph*, int);
+LabelKey makeLabelKey(const char*);
+int compareKeyIndex(const void*, const void*);
+void buildLabelIndex(Graph*);
+int findLabelKey(const LabelKey[], int, LabelKey);
+GraphCSR* buildCSR(const Graph*);
+int compareInt(const void*, const void*);
+GraphCSR* buildSortedCSR(const Graph*);
+GraphCSR* freeCSR(GraphCSR*);
+void computeVertexOrder(const GraphCSR*, ReorderMode, int[]);
+int ReorderGraph(Graph*, ReorderMode);
+
+int popcount64(uint64_t);
+int lowestBit64(uint64_t);
+int isDenseGraph(const Graph*);
+BitMatrix* createBitMatrix(int);
+BitMatrix* buildBitMatrix(const Graph*);
+BitMatrix* freeBitMatrix(BitMatrix*);
+void setBit(BitMatrix*, int, int);
+int hasEdge(const BitMatrix*, int, int);
+int bitRowDegree(const BitMatrix*, int);
+int bitMatrixBFS(const BitMatrix*, int, int[]);
+void initTraversalLimits(TraversalLimits*);
+TraversalStop checkVisitStop(const Graph*, int, int, int, const TraversalLimits*, VertexVisitor, void*);
+TraversalStop DFSBounded(const Graph*, int, const TraversalLimits*, VertexVisitor, void*, int*);
+TraversalStop BFSBounded(const Graph*, int, const TraversalLimits*, VertexVisitor, void*, int*);
+int DFSVisit(const Graph*, int, VertexVisitor, void*);
+int BFSVisit(const Graph*, int, VertexVisitor, void*);
+int collectVisitor(const Graph*, int, int, void*);
+int writeVisitor(const Graph*, int, int, void*);
+int DFS(const Graph*, const char*, const char*[]);
+int BFS(const Graph*, const char*, const char*[]);
 
 void ProduceSetsFile(const Graph* g, const char* inputFilename);
 void ProduceDegreeFile(const Graph* g, const char* inputFilename);
@@ -58,7 +443,117 @@ void ProduceListFile(const Graph* g, const char* inputFilename);
 int matrixHelper(const Graph* g);
 void ProduceMatrixFile(const Graph* g, const char* inputFilename);
 
-void ProduceBFSFile(const Graph* g, const char* inputFilename, const strName startVertex);
-void ProduceDFSFile(const Graph* g, const char* inputFilename, const strName startVertex);
+void ProduceBFSFile(const Graph* g, const char* inputFilename, const char* startVertex);
+void ProduceDFSFile(const Graph* g, const char* inputFilename, const char* startVertex);
+
+int intersectCount(const int*, int, const int*, int);
+void countTriangles(const GraphCSR*, int[]);
+void ProduceTrianglesFile(const Graph* g, const char* inputFilename);
+
+GraphCSR* transposeCSR(const GraphCSR*);
+void initPageRankParams(PageRankParams*);
+int computePageRank(const GraphCSR*, const PageRankParams*, double[]);
+double roundScore(double, double);
+int compareScoresAt(const VertexScore*, const VertexScore*, double);
+int compareRankScore(const void*, const void*);
+int compareBetweennessScore(const void*, const void*);
+void ProduceRankFile(const Graph* g, const char* inputFilename);
+
+void initBrandesWorkspace(BrandesWorkspace*, int);
+void freeBrandesWorkspace(BrandesWorkspace*);
+void brandesAccumulate(const GraphCSR*, int, BrandesWorkspace*, double[]);
+int computeBetweenness(const GraphCSR*, int, unsigned int, double[]);
+void ProduceBetweennessFile(const Graph* g, const char* inputFilename);
+
+void initBFSWorkspace(BFSWorkspace*, int);
+void freeBFSWorkspace(BFSWorkspace*);
+int bfsDistances(const GraphCSR*, int, BFSWorkspace*);
+int componentDiameter(const GraphCSR*, int, BFSWorkspace*, int[], int[], int[], DiameterResult*);
+int computeDiameter(const GraphCSR*, int, int[], DiameterResult*);
+void ProduceEccentricityFile(const Graph* g, const char* inputFilename);
+
+unsigned int zigzagEncode(int);
+int zigzagDecode(unsigned int);
+int writeVarint(unsigned char*, unsigned int);
+unsigned int readVarint(const unsigned char**);
+size_t encodeNeighborBlock(unsigned char*, int, const int[], int);
+void setBlockOffset(CompressedGraph*, int, size_t);
+CompressedGraph* compressCSR(const GraphCSR*);
+CompressedGraph* compressGraphByLabel(const Graph*, int[]);
+CompressedGraph* freeCompressedGraph(CompressedGraph*);
+int ReadCompressedInputFile(strFile, CompressedInput**);
+CompressedInput* freeCompressedInput(CompressedInput*);
+int compressedVertexIndex(const CompressedInput*, const char*);
+const unsigned char* compressedBlock(const CompressedGraph*, int);
+int compressedDegree(const CompressedGraph*, int);
+void openNeighbors(const CompressedGraph*, int, NeighborCursor*);
+int nextNeighbor(NeighborCursor*, int*);
+int decodeNeighbors(const CompressedGraph*, int, int[]);
+int compressedBFS(const CompressedGraph*, int, BFSWorkspace*);
+int compressedDFS(const CompressedGraph*, int, int[]);
+void ProduceCompressedDegreeFile(const CompressedInput*, const char*);
+void ProduceCompressedTraversalFile(const CompressedInput*, const char*, const char*, int);
+
+int ConvertInputToGraphFile(strFile, const char*);
+OOCGraph* openGraphFile(const char*, int);
+OOCGraph* closeGraphFile(OOCGraph*);
+const unsigned char* oocPage(OOCGraph*, long long);
+unsigned int oocReadVarint(OOCGraph*, uint64_t*);
+int oocDegree(OOCGraph*, int);
+int oocNeighbors(OOCGraph*, int, int**, int*);
+int oocVertexIndex(const OOCGraph*, const char*);
+const char* oocVertexLabel(const OOCGraph*, int);
+LabelKey oocVertexKey(const OOCGraph*, int);
+int oocSortedNeighbors(OOCGraph*, int, KeyIndex**, int*);
+int oocBFSVisit(OOCGraph*, int, OOCVisitor, void*);
+int oocDFSVisit(OOCGraph*, int, OOCVisitor, void*);
+int oocWriteVisitor(const OOCGraph*, int, int, void*);
+void ProduceOOCDegreeFile(OOCGraph* g, const char* inputFilename);
+void ProduceOOCListFile(OOCGraph* g, const char* inputFilename);
+void ProduceOOCTraversalFile(OOCGraph* g, const char* inputFilename, const char* startVertex, int depthFirst);
+
+Graph* cloneGraph(const Graph*);
+GraphStore* createGraphStore(Graph*, int);
+const Graph* snapshotAcquire(GraphStore*, int);
+void snapshotRelease(GraphStore*, int);
+void lockGraphStore(GraphStore*);
+void unlockGraphStore(GraphStore*);
+int reclaimRetired(GraphStore*);
+int reclaimSnapshots(GraphStore*);
+void publishGraph(GraphStore*, Graph*);
+GraphStore* freeGraphStore(GraphStore*);
+
+int labelComponents(const GraphCSR*, int[]);
+int shardOwner(const ShardedGraph*, int);
+int shardLocalIndex(const ShardedGraph*, int);
+ShardedGraph* partitionGraph(const Graph*, int, PartitionMode);
+ShardedGraph* freeShardedGraph(ShardedGraph*);
+#ifndef _WIN32
+int writeAll(int, const void*, size_t);
+int readAll(int, void*, size_t);
+void sendShardMessage(int, int, const FrontierEntry*, int);
+int recvShardMessage(int, int*, FrontierEntry**, int*);
+void shardWorkerLoop(const ShardedGraph*, const GraphShard*, int, int);
+int startShardWorkers(const ShardedGraph*, ShardWorker[]);
+void stopShardWorkers(int, ShardWorker[]);
+int compareFrontierEntry(const void*, const void*);
+int shardRound(const ShardedGraph*, ShardWorker[], int, const FrontierEntry*, int, FrontierEntry**, int*);
+int shardedBFS(const ShardedGraph*, ShardWorker[], int, int[], int[]);
+int shardedComponents(const ShardedGraph*, ShardWorker[], int[]);
+#endif
+
+void initSparseMap(SparseVertexMap*, int);
+void freeSparseMap(SparseVertexMap*);
+int sparseMapSlot(const SparseVertexMap*, int);
+int sparseMapGet(const SparseVertexMap*, int);
+void sparseMapPut(SparseVertexMap*, int, int);
+int isBoundedTraversal(const Graph*, const TraversalLimits*);
+void initVisitedSet(VisitedSet*, int, int);
+void freeVisitedSet(VisitedSet*);
+int visitedGet(const VisitedSet*, int);
+void visitedPut(VisitedSet*, int, int);
+Graph* extractEgoNetwork(const Graph*, int, int);
+int WriteInputFile(const Graph*, const char*);
+void ProduceEgoFile(const Graph* g, const char* inputFilename, const char* startVertex, int hops);
 
 #endif
@@ -1,18 +1,163 @@
 #include "graph.h"
 
-int main() {
+/**
+    Purpose: Produces the reports the compressed form supports (DEGREE, BFS, DFS) without building adjacency lists.
+    Returns: Exit status for main
+    @param  : fileName - name of the input file
+    Post-condition:
+             - The graph is read straight into delta-encoded blocks (see
+               ReadCompressedInputFile); the list-based reports are not written.
+*/
+int runCompressed(strFile fileName) {
+    CompressedInput* ci = NULL;
+    strName vertex;
+
+    int loaded = ReadCompressedInputFile(fileName, &ci);
+    if (loaded == 0) {
+        printf("File %s not found.\n", fileName);
+        exit(1);
+    } else if (loaded < 0) {
+        printf("File %s is not a valid graph file.\n", fileName);
+        exit(1);
+    }
+    ProduceCompressedDegreeFile(ci, fileName);   // Output #2: Vertex degrees
+
+    printf("Input start vertex for traversal: ");
+    scanf("%255s", vertex);
+    if (compressedVertexIndex(ci, vertex) < 0) {
+        printf("Vertex %s not found.\n", vertex);
+        ci = freeCompressedInput(ci);
+        exit(1);
+    }
+    ProduceCompressedTraversalFile(ci, fileName, vertex, 0);   // Output #5: BFS traversal
+    ProduceCompressedTraversalFile(ci, fileName, vertex, 1);   // Output #6: DFS traversal
+
+    ci = freeCompressedInput(ci);
+    return 0;
+}
+
+/**
+    Purpose: Produces DEGREE, LIST, BFS and DFS from an on-disk graph file without building a Graph.
+    Returns: Exit status for main
+    @param  : fileName - a graph file, or a text input converted to <input>-GRAPH.BIN first
+    Post-condition:
+             - Only labels, offsets and OOC_CACHE_PAGES adjacency pages are held in
+               memory (see openGraphFile); the converted file is kept for reuse.
+*/
+int runOutOfCore(strFile fileName) {
+    char graphFileName[MAX_FILE_NAME_LEN + 16];
+    strName vertex;
+    int i = 0;
+
+    OOCGraph* disk = openGraphFile(fileName, OOC_CACHE_PAGES);
+    if (disk == NULL) {   // a text input: convert it next to the reports
+        strcpy(graphFileName, fileName);
+        while (graphFileName[i] != '\0' && graphFileName[i] != '.') {
+            i++;
+        }
+        graphFileName[i] = '\0';
+        strcat(graphFileName, "-GRAPH.BIN");
+        if (!ConvertInputToGraphFile(fileName, graphFileName)) {
+            printf("File %s not found or not a valid graph file.\n", fileName);
+            exit(1);
+        }
+        disk = openGraphFile(graphFileName, OOC_CACHE_PAGES);
+        if (disk == NULL) {
+            printf("File %s could not be read back.\n", graphFileName);
+            exit(1);
+        }
+    }
+    ProduceOOCDegreeFile(disk, fileName);   // Output #2: Vertex degrees
+    ProduceOOCListFile(disk, fileName);     // Output #3: Adjacency list
+
+    printf("Input start vertex for traversal: ");
+    scanf("%255s", vertex);
+    if (oocVertexIndex(disk, vertex) < 0) {
+        printf("Vertex %s not found.\n", vertex);
+        disk = closeGraphFile(disk);
+        exit(1);
+    }
+    ProduceOOCTraversalFile(disk, fileName, vertex, 0);   // Output #5: BFS traversal
+    ProduceOOCTraversalFile(disk, fileName, vertex, 1);   // Output #6: DFS traversal
+
+    disk = closeGraphFile(disk);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     Graph* g = NULL;
     strFile fileName;
     strName vertex;
+    int reorder = -1;   // keep the input numbering unless asked otherwise
+    int compressed = 0; // build the lists unless asked otherwise
+    int outOfCore = 0;  // keep the adjacency data in memory unless asked otherwise
+    int edgeList = 0;   // read the adjacency format unless asked otherwise
+    int symmetrize = 0; // with --edge-list: add v -> u for every u -> v
+    int egoHops = EGO_HOPS;
+    int egoSet = 0;
+
+    /* 0. Options: input format, vertex renumbering, compressed or on-disk mode, EGO radius */
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reorder-rcm") == 0) {
+            reorder = REORDER_RCM;
+        } else if (strcmp(argv[i], "--reorder-degree") == 0) {
+            reorder = REORDER_DEGREE;
+        } else if (strcmp(argv[i], "--compressed") == 0) {
+            compressed = 1;
+        } else if (strcmp(argv[i], "--out-of-core") == 0) {
+            outOfCore = 1;
+        } else if (strcmp(argv[i], "--edge-list") == 0) {
+            edgeList = 1;
+        } else if (strcmp(argv[i], "--symmetrize") == 0) {
+            symmetrize = 1;
+        } else if (strcmp(argv[i], "--ego-hops") == 0 && i + 1 < argc &&
+                   sscanf(argv[i + 1], "%d", &egoHops) == 1 && egoHops >= 0) {
+            egoSet = 1;
+            i++;
+        } else {
+            printf("Unknown option %s (use --reorder-rcm, --reorder-degree, --compressed, --out-of-core, "
+                   "--edge-list [--symmetrize] or --ego-hops K).\n", argv[i]);
+            exit(1);
+        }
+    }
+    if (symmetrize && !edgeList) {
+        printf("--symmetrize only applies to --edge-list.\n");
+        exit(1);
+    }
+    if (edgeList && (compressed || outOfCore)) {
+        printf("--edge-list builds the adjacency lists; --compressed and --out-of-core read the adjacency format.\n");
+        exit(1);
+    }
+    if (compressed && (reorder >= 0 || egoSet || outOfCore)) {
+        printf("--compressed writes DEGREE, BFS and DFS only; --reorder-*, --out-of-core and --ego-hops do not apply.\n");
+        exit(1);
+    }
+    if (outOfCore && (reorder >= 0 || egoSet)) {
+        printf("--out-of-core writes DEGREE, LIST, BFS and DFS only; --reorder-* and --ego-hops do not apply.\n");
+        exit(1);
+    }
 
     /* 1. Read input file */
     printf("Input filename: ");
     scanf("%s", fileName);
+    if (compressed) {   // DEGREE, BFS and DFS from the delta-encoded blocks; no lists are built
+        return runCompressed(fileName);
+    }
+    if (outOfCore) {    // DEGREE, LIST, BFS and DFS paged in from the graph file
+        return runOutOfCore(fileName);
+    }
 
     /* 2. Process graph file */
-    if (!ReadInputFile(fileName, &g)) {
+    int loaded = edgeList ? ReadEdgeListFile(fileName, &g, symmetrize) : ReadInputFileParallel(fileName, &g, 0);
+    if (loaded == 0) {
         printf("File %s not found.\n", fileName);
         exit(1);
+    } else if (loaded < 0) {
+        printf("File %s is not a valid graph file.\n", fileName);
+        exit(1);
+    }
+    if (reorder >= 0) {
+        ReorderGraph(g, (ReorderMode) reorder);   // reports still print by label
     }
 
     /* 3. Generate all required output files, whether the vertex exists or not */
@@ -20,10 +165,14 @@ int main() {
     ProduceDegreeFile(g, fileName);   // Output #2: Vertex degrees
     ProduceListFile(g, fileName);     // Output #3: Adjacency list
     ProduceMatrixFile(g, fileName);   // Output #4: Adjacency matrix
+    ProduceTrianglesFile(g, fileName); // Triangle counts and clustering coefficients
+    ProduceRankFile(g, fileName);     // PageRank, highest first
+    ProduceBetweennessFile(g, fileName); // Betweenness centrality, highest first
+    ProduceEccentricityFile(g, fileName); // Eccentricities, diameter and radius
 
     /* 4. Get traversal starting vertex */
     printf("Input start vertex for traversal: ");
-    scanf("%s", vertex);
+    scanf("%255s", vertex);
     
     /* 5. Check if starting vertex exists */
     if (getVertexIndex(g, vertex) < 0) {    // Does not exist
@@ -31,10 +180,11 @@ int main() {
         g = freeGraph(g);
         exit(1);
     }
-    else    // If vertex exists, produce outputs 5 and 6
+    else    // If vertex exists, produce outputs 5 and 6 and the ego network
     {
-            ProduceBFSFile(g, fileName, vertex);  // Output #5: BFS traversal
-            ProduceDFSFile(g, fileName, vertex);  // Output #6: DFS traversal
+        ProduceBFSFile(g, fileName, vertex);  // Output #5: BFS traversal
+        ProduceDFSFile(g, fileName, vertex);  // Output #6: DFS traversal
+        ProduceEgoFile(g, fileName, vertex, egoHops);   // Subgraph within egoHops of the vertex
     }
 
     /* 6. Cleanup */
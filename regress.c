@@ -0,0 +1,1271 @@
+#include "graph.c"
+/*
+    Regression checks for the library entry points. Each check runs a new code
+    path against the plain in-memory one (or a known answer) on the sample
+    inputs and on small fixtures written to the working directory.
+
+    Build and run from the repository root:
+        gcc regress.c -lm -fopenmp -o regress && ./regress
+    Exit status is the number of failed checks.
+*/
+
+int failures = 0;
+
+/*
+    Purpose: Records the outcome of one check.
+    Returns: void
+    @param  : ok   — nonzero if the check passed
+    @param  : what — short description printed on failure
+    Post-condition:
+             - failures is incremented when ok is 0.
+*/
+void check(int ok, const char* what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+/*
+    Purpose: Writes a fixture file.
+    Returns: void
+    @param  : fileName — file to create (overwritten)
+    @param  : text     — exact contents
+*/
+void writeFixture(const char* fileName, const char* text) {
+    FILE* fp = fopen(fileName, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "cannot write fixture %s\n", fileName);
+        exit(1);
+    }
+    fputs(text, fp);
+    fclose(fp);
+}
+
+/*
+    Purpose: Loads an input file with the serial loader.
+    Returns: The graph
+    @param  : fileName — input file in ReadInputFile format
+*/
+Graph* loadGraph(const char* fileName) {
+    Graph* g = NULL;
+    strFile name;
+    strcpy(name, fileName);
+    if (!ReadInputFile(name, &g)) {
+        fprintf(stderr, "cannot load %s\n", fileName);
+        exit(1);
+    }
+    return g;
+}
+
+/*
+    Purpose: Joins a traversal into one space-separated string.
+    Returns: void
+    @param  : labels — labels in visit order
+    @param  : count  — number of labels
+    @param  : out    — destination, large enough for the joined labels
+*/
+void joinLabels(const char* labels[], int count, char* out) {
+    out[0] = '\0';
+    for (int i = 0; i < count; i++) {
+        if (i > 0) {
+            strcat(out, " ");
+        }
+        strcat(out, labels[i]);
+    }
+}
+
+/*
+    Purpose: Checks a file's contents against the expected text, then deletes it.
+    Returns: 1 if the contents match exactly; 0 otherwise
+    @param  : fileName — file to read
+    @param  : expected — exact expected contents
+*/
+int fileHolds(const char* fileName, const char* expected) {
+    FILE* fp = fopen(fileName, "rb");
+    int same = fp != NULL;
+    size_t i = 0;
+    while (same) {
+        int c = fgetc(fp);
+        if (c == EOF) {
+            same = expected[i] == '\0';
+            break;
+        }
+        same = expected[i] != '\0' && (char) c == expected[i];
+        i++;
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    remove(fileName);
+    return same;
+}
+
+/*
+    Purpose: Writes a random undirected graph in ReadInputFile format.
+    Returns: void
+    @param  : fileName — file to create
+    @param  : n        — number of vertices
+    @param  : edges    — number of random edges to try (self-loops are skipped)
+    @param  : seed     — seed for the generator, so every run writes the same file
+    Post-condition:
+             - Every edge is listed at both ends; some are listed twice, and
+               labels are not in index order, so sorting matters.
+*/
+void writeRandomGraph(const char* fileName, int n, int edges, unsigned int seed) {
+    int* from = malloc(edges * sizeof(int));
+    int* to = malloc(edges * sizeof(int));
+    int e, v;
+    for (e = 0; e < edges; e++) {
+        seed = seed * 1103515245u + 12345u;
+        from[e] = (int) ((seed >> 8) % (unsigned int) n);
+        seed = seed * 1103515245u + 12345u;
+        to[e] = (int) ((seed >> 8) % (unsigned int) n);
+    }
+    FILE* fp = fopen(fileName, "w");
+    fprintf(fp, "%d\n", n);
+    for (v = 0; v < n; v++) {
+        fprintf(fp, "x%d", (v * 7919) % n);
+        for (e = 0; e < edges; e++) {
+            if (from[e] != to[e] && (from[e] == v || to[e] == v)) {
+                fprintf(fp, " x%d", ((from[e] == v ? to[e] : from[e]) * 7919) % n);
+            }
+        }
+        fprintf(fp, " -1\n");
+    }
+    fclose(fp);
+    free(from);
+    free(to);
+}
+
+/*
+    Purpose: Compares two graphs list by list, by label text.
+    Returns: 1 if both have the same vertices and lists in the same order; 0 otherwise
+    @param  : a — first graph
+    @param  : b — second graph
+*/
+int sameGraph(const Graph* a, const Graph* b) {
+    if (a->numVertices != b->numVertices) {
+        return 0;
+    }
+    for (int i = 0; i < a->numVertices; i++) {
+        Node* x = a->adjList[vertexAtInputPos(a, i)].head;
+        Node* y = b->adjList[vertexAtInputPos(b, i)].head;
+        while (x != NULL && y != NULL) {
+            if (strcmp(labelText(a->labels, x->label), labelText(b->labels, y->label)) != 0) {
+                return 0;
+            }
+            x = x->edge;
+            y = y->edge;
+        }
+        if (x != NULL || y != NULL) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* A report writer taking only the graph and the input file name. */
+typedef void (*ReportFn)(const Graph*, const char*);
+
+/*
+    Purpose: Checks that two files have identical contents, then deletes both.
+    Returns: 1 if identical; 0 otherwise (or if either is missing)
+    @param  : fileA — first file
+    @param  : fileB — second file
+*/
+int sameFiles(const char* fileA, const char* fileB) {
+    FILE* a = fopen(fileA, "rb");
+    FILE* b = fopen(fileB, "rb");
+    int same = a != NULL && b != NULL;
+    while (same) {
+        int ca = fgetc(a);
+        int cb = fgetc(b);
+        same = ca == cb;
+        if (ca == EOF || cb == EOF) {
+            break;
+        }
+    }
+    if (a != NULL) {
+        fclose(a);
+    }
+    if (b != NULL) {
+        fclose(b);
+    }
+    remove(fileA);
+    remove(fileB);
+    return same;
+}
+
+/*
+    Purpose: Writes one report for two graphs and compares the outputs.
+    Returns: 1 if the reports are identical; 0 otherwise
+    @param  : produce — report writer (e.g. ProduceListFile)
+    @param  : a       — first graph, reported as rg_a.txt
+    @param  : b       — second graph, reported as rg_b.txt
+    @param  : suffix  — report suffix, e.g. "LIST"
+*/
+int sameReport(ReportFn produce, const Graph* a, const Graph* b, const char* suffix) {
+    char fileA[64], fileB[64];
+    produce(a, "rg_a.txt");
+    produce(b, "rg_b.txt");
+    sprintf(fileA, "rg_a-%s.TXT", suffix);
+    sprintf(fileB, "rg_b-%s.TXT", suffix);
+    return sameFiles(fileA, fileB);
+}
+
+/* Visitor that stops the traversal once ctx (an int budget) reaches zero. */
+int budgetVisitor(const Graph* g, int vIndex, int depth, void* ctx) {
+    int* left = ctx;
+    (void) g;
+    (void) vIndex;
+    (void) depth;
+    (*left)--;
+    return *left <= 0;
+}
+
+/*
+    Purpose: Checks the visitor-based BFS/DFS against the known sample orders.
+    Returns: void
+*/
+void checkVisitorTraversals(void) {
+    Graph* g = loadGraph("T.txt");
+    const char* order[8];
+    char joined[256];
+
+    joinLabels(order, BFS(g, "A", order), joined);
+    check(strcmp(joined, "A B C E D") == 0, "BFS order on T.txt");
+    joinLabels(order, DFS(g, "A", order), joined);
+    check(strcmp(joined, "A B C D E") == 0, "DFS order on T.txt");
+
+    int budget = 2;
+    check(BFSVisit(g, 0, budgetVisitor, &budget) == 2, "BFSVisit stops when the visitor asks");
+    budget = 3;
+    check(DFSVisit(g, 0, budgetVisitor, &budget) == 3, "DFSVisit stops when the visitor asks");
+    g = freeGraph(g);
+
+    g = loadGraph("V.txt");
+    const char* big[20];
+    joinLabels(big, BFS(g, "Bruce", big), joined);
+    check(strcmp(joined, "Bruce Jason Jinu Lex BRUCE Gwima Rumi Gardner Lois Baby Zoey Diana Clark Doctor") == 0,
+          "BFS order on V.txt");
+    joinLabels(big, DFS(g, "Bruce", big), joined);
+    check(strcmp(joined, "Bruce Jason BRUCE Jinu Gwima Baby Zoey Doctor Rumi Lex Gardner Diana Lois Clark") == 0,
+          "DFS order on V.txt");
+    g = freeGraph(g);
+}
+
+/*
+    Purpose: Checks the depth, target and budget limits of BFSBounded/DFSBounded.
+    Returns: void
+*/
+void checkBoundedTraversals(void) {
+    Graph* g = loadGraph("V.txt");
+    TraversalLimits lim;
+    int count = 0;
+    int bruce = getVertexIndex(g, "Bruce");
+
+    initTraversalLimits(&lim);
+    lim.maxDepth = 1;
+    check(BFSBounded(g, bruce, &lim, NULL, NULL, &count) == TRAV_DEPTH_LIMIT && count == 4,
+          "BFSBounded depth 1 from Bruce visits 4 and reports the cut");
+    lim.maxDepth = 6;
+    check(BFSBounded(g, bruce, &lim, NULL, NULL, &count) == TRAV_EXHAUSTED && count == 14,
+          "BFSBounded depth 6 reaches the whole component");
+
+    initTraversalLimits(&lim);
+    lim.target = getVertexIndex(g, "Zoey");
+    check(DFSBounded(g, bruce, &lim, NULL, NULL, &count) == TRAV_TARGET_FOUND && count == 7,
+          "DFSBounded stops on the target");
+    check(BFSBounded(g, bruce, &lim, NULL, NULL, &count) == TRAV_TARGET_FOUND && count == 11,
+          "BFSBounded stops on the target");
+
+    initTraversalLimits(&lim);
+    lim.maxVisits = 3;
+    check(DFSBounded(g, bruce, &lim, NULL, NULL, &count) == TRAV_BUDGET && count == 3,
+          "DFSBounded stops at the visit budget");
+    lim.maxVisits = 0;
+    check(DFSBounded(g, bruce, &lim, NULL, NULL, &count) == TRAV_BUDGET && count == 0 &&
+          BFSBounded(g, bruce, &lim, NULL, NULL, &count) == TRAV_BUDGET && count == 0,
+          "a visit budget of 0 visits nothing");
+
+    // a depth limit nothing reaches takes the sparse path; no limits the dense one
+    const char* dense[20];
+    const char* sparse[20];
+    for (int depthFirst = 0; depthFirst <= 1; depthFirst++) {
+        TraversalCollector full = { dense, 0 }, bounded = { sparse, 0 };
+        initTraversalLimits(&lim);
+        lim.maxDepth = 100;
+        if (depthFirst) {
+            DFSBounded(g, bruce, NULL, collectVisitor, &full, NULL);
+            DFSBounded(g, bruce, &lim, collectVisitor, &bounded, NULL);
+        } else {
+            BFSBounded(g, bruce, NULL, collectVisitor, &full, NULL);
+            BFSBounded(g, bruce, &lim, collectVisitor, &bounded, NULL);
+        }
+        int same = full.count == bounded.count && full.count == 14;
+        for (int i = 0; same && i < full.count; i++) {
+            same = strcmp(dense[i], sparse[i]) == 0;
+        }
+        check(same, "dense and sparse visited sets give the same traversal");
+    }
+    g = freeGraph(g);
+
+    // C is cut at depth 2 under S-A-B but then reached directly from S
+    writeFixture("rg_cut.txt", "4\nS A C -1\nA S B -1\nB A C -1\nC S B -1\n");
+    g = loadGraph("rg_cut.txt");
+    initTraversalLimits(&lim);
+    lim.maxDepth = 2;
+    check(DFSBounded(g, 0, &lim, NULL, NULL, &count) == TRAV_EXHAUSTED && count == 4,
+          "DFSBounded does not report a cut vertex reached by a shorter path");
+    lim.maxDepth = 1;
+    check(DFSBounded(g, 0, &lim, NULL, NULL, &count) == TRAV_DEPTH_LIMIT && count == 3,
+          "DFSBounded reports a vertex that is never reached");
+    g = freeGraph(g);
+    remove("rg_cut.txt");
+
+    // a long path: recursion or per-level V-sized arrays would overflow the stack
+    int n = 100000;
+    FILE* fp = fopen("rg_path.txt", "w");
+    fprintf(fp, "%d\n", n);
+    for (int i = 0; i < n; i++) {
+        fprintf(fp, "p%d", i);
+        if (i > 0) {
+            fprintf(fp, " p%d", i - 1);
+        }
+        if (i + 1 < n) {
+            fprintf(fp, " p%d", i + 1);
+        }
+        fprintf(fp, " -1\n");
+    }
+    fclose(fp);
+    g = loadGraph("rg_path.txt");
+    check(DFSVisit(g, 0, NULL, NULL) == n, "DFSVisit walks a 100000-vertex path");
+    check(BFSVisit(g, 0, NULL, NULL) == n, "BFSVisit walks a 100000-vertex path");
+    g = freeGraph(g);
+    remove("rg_path.txt");
+}
+
+/*
+    Purpose: Checks that reordering vertices leaves every label-ordered result unchanged.
+    Returns: void
+*/
+void checkReorder(void) {
+    const char* files[3] = { "T.txt", "V.txt", "U.txt" };
+    const char* starts[3] = { "A", "Bruce", "Clark" };
+    for (int f = 0; f < 3; f++) {
+        for (int mode = REORDER_DEGREE; mode <= REORDER_RCM; mode++) {
+            Graph* plain = loadGraph(files[f]);
+            Graph* moved = loadGraph(files[f]);
+            ReorderGraph(moved, (ReorderMode) mode);
+
+            const char* orderA[20];
+            const char* orderB[20];
+            char joinedA[512], joinedB[512];
+            joinLabels(orderA, BFS(plain, starts[f], orderA), joinedA);
+            joinLabels(orderB, BFS(moved, starts[f], orderB), joinedB);
+            check(strcmp(joinedA, joinedB) == 0, "reordering keeps the BFS order");
+            joinLabels(orderA, DFS(plain, starts[f], orderA), joinedA);
+            joinLabels(orderB, DFS(moved, starts[f], orderB), joinedB);
+            check(strcmp(joinedA, joinedB) == 0, "reordering keeps the DFS order");
+
+            check(sameReport(ProduceSetsFile, plain, moved, "SET"), "reordering keeps the SET report");
+            check(sameReport(ProduceDegreeFile, plain, moved, "DEGREE"), "reordering keeps the DEGREE report");
+            check(sameReport(ProduceListFile, plain, moved, "LIST"), "reordering keeps the LIST report");
+            check(sameReport(ProduceMatrixFile, plain, moved, "MATRIX"), "reordering keeps the MATRIX report");
+            plain = freeGraph(plain);
+            moved = freeGraph(moved);
+        }
+    }
+
+    // vertices sharing a label must keep their file order in label-sorted reports
+    writeFixture("rg_shared.txt", "4\nB A -1\nA B B C -1\nB A C -1\nC A B -1\n");
+    for (int mode = REORDER_DEGREE; mode <= REORDER_RCM; mode++) {
+        Graph* plain = loadGraph("rg_shared.txt");
+        Graph* moved = loadGraph("rg_shared.txt");
+        ReorderGraph(moved, (ReorderMode) mode);
+        check(sameReport(ProduceDegreeFile, plain, moved, "DEGREE"), "reordering keeps DEGREE ties in file order");
+        plain = freeGraph(plain);
+        moved = freeGraph(moved);
+    }
+    remove("rg_shared.txt");
+}
+
+/*
+    Purpose: Checks label keys, label ranks and the (SIMD) key search.
+    Returns: void
+*/
+void checkLabelKeys(void) {
+    const char* pairs[6][2] = {
+        { "A", "B" }, { "Bruce", "BRUCE" }, { "ab", "abc" },
+        { "Zoey", "a" }, { "abcdefgh", "abcdefgi" }, { "x", "x" }
+    };
+    for (int i = 0; i < 6; i++) {
+        int byText = strcmp(pairs[i][0], pairs[i][1]);
+        LabelKey a = makeLabelKey(pairs[i][0]);
+        LabelKey b = makeLabelKey(pairs[i][1]);
+        int byKey = (a > b) - (a < b);
+        check((byText > 0) - (byText < 0) == byKey, "makeLabelKey orders like strcmp");
+    }
+
+    // labels sharing their first 8 characters must still rank apart
+    LabelArena* arena = createLabelArena(4);
+    int late = internLabel(arena, "prefix00-zzz", 12);
+    int early = internLabel(arena, "prefix00-aaa", 12);
+    int shortest = internLabel(arena, "prefix00", 8);
+    rankLabels(arena);
+    check(arena->rank[shortest] < arena->rank[early] && arena->rank[early] < arena->rank[late],
+          "rankLabels breaks 8-character prefix ties");
+    check(findLabel(arena, "prefix00-aaa", 12) == early && findLabel(arena, "prefix00-a", 10) < 0,
+          "findLabel matches whole labels only");
+    arena = freeLabelArena(arena);
+
+    // qsort is not stable: equal keys must still come out by index
+    KeyIndex tied[3] = { { 7, 2 }, { 7, 0 }, { 3, 1 } };
+    qsort(tied, 3, sizeof(KeyIndex), compareKeyIndex);
+    check(tied[0].index == 1 && tied[1].index == 0 && tied[2].index == 2,
+          "compareKeyIndex breaks label ties on the index");
+
+    // shared labels print in file order, however the vertices are numbered
+    writeFixture("rg_shared.txt", "6\nS A B -1\nA S S B -1\nS A -1\nB S A S -1\nS -1\nS B -1\n");
+    Graph* plain = loadGraph("rg_shared.txt");
+    Graph* reordered = loadGraph("rg_shared.txt");
+    ReorderGraph(reordered, REORDER_DEGREE);
+    check(sameReport(ProduceTrianglesFile, plain, reordered, "TRIANGLES") &&
+          sameReport(ProduceEccentricityFile, plain, reordered, "ECC"),
+          "TRIANGLES/ECC keep shared labels in file order after reordering");
+    plain = freeGraph(plain);
+    reordered = freeGraph(reordered);
+    remove("rg_shared.txt");
+
+    // every length around the 4-key SIMD step, every position, plus near misses
+    LabelKey keys[11];
+    for (int count = 0; count <= 11; count++) {
+        for (int i = 0; i < count; i++) {
+            keys[i] = ((LabelKey) 0x01020304u << 32) | (LabelKey) (i + 1);
+        }
+        for (int i = 0; i < count; i++) {
+            check(findLabelKey(keys, count, keys[i]) == i, "findLabelKey finds every position");
+        }
+        LabelKey halfMatch = ((LabelKey) 0x0A0B0C0Du << 32) | 1u;   // low half equals keys[0]
+        check(findLabelKey(keys, count, halfMatch) == -1, "findLabelKey needs both 32-bit halves");
+        check(findLabelKey(keys, count, 0) == -1, "findLabelKey reports a missing key");
+    }
+}
+
+/*
+    Purpose: Checks that labels of any length are stored once and survive every loader and copy.
+    Returns: void
+*/
+void checkLabelArena(void) {
+    char longName[1201], text[4096];
+    memset(longName, 'q', 1200);
+    longName[1200] = '\0';
+    sprintf(text, "3\n%s A A -1\nA %s B -1\nB A %s -1\n", longName, longName, longName);
+    writeFixture("rg_long.txt", text);
+
+    Graph* g = loadGraph("rg_long.txt");
+    check(g->labels->count == 3, "each distinct label is interned once");
+    check(strcmp(vertexLabel(g, 0), longName) == 0, "a label longer than MAX_LABEL_LEN is kept whole");
+    check(getVertexIndex(g, longName) == 0, "a long label can be looked up");
+
+    Graph* copy = cloneGraph(g);
+    check(sameGraph(g, copy) && copy->labels != g->labels && strcmp(vertexLabel(copy, 0), longName) == 0,
+          "cloneGraph copies the label arena");
+    copy = freeGraph(copy);
+
+    Graph* parallel = NULL;
+    strFile name;
+    strcpy(name, "rg_long.txt");
+    check(ReadInputFileParallel(name, &parallel, 2) == 1 && sameGraph(g, parallel),
+          "parallel loader keeps long labels");
+    parallel = freeGraph(parallel);
+
+    const char* order[3];
+    char joined[4096];
+    joinLabels(order, BFS(g, "B", order), joined);
+    sprintf(text, "B A %s", longName);
+    check(strcmp(joined, text) == 0, "BFS prints long labels");
+    g = freeGraph(g);
+    remove("rg_long.txt");
+}
+
+/* Visitor recording each vertex's depth into ctx (an int array). */
+int depthVisitor(const Graph* g, int vIndex, int depth, void* ctx) {
+    int* level = ctx;
+    (void) g;
+    level[vIndex] = depth;
+    return 0;
+}
+
+/*
+    Purpose: Checks the bit matrix against the lists, and that dense graphs report like sparse ones.
+    Returns: void
+*/
+void checkBitMatrix(void) {
+    Graph* g = loadGraph("V.txt");
+    BitMatrix* m = buildBitMatrix(g);
+    int n = g->numVertices, u, v;
+    int* row = malloc(n * sizeof(int));
+    int* level = malloc(n * sizeof(int));
+    int* expected = malloc(n * sizeof(int));
+    for (u = 0; u < n; u++) {
+        int cnt = getSortedNeighbors(g, u, row);
+        int agree = bitRowDegree(m, u) == cnt;
+        for (v = 0; v < cnt; v++) {
+            agree = agree && hasEdge(m, u, row[v]);
+        }
+        check(agree, "bit matrix rows match the adjacency lists");
+
+        for (v = 0; v < n; v++) {
+            expected[v] = -1;
+        }
+        BFSVisit(g, u, depthVisitor, expected);
+        bitMatrixBFS(m, u, level);
+        check(memcmp(level, expected, n * sizeof(int)) == 0, "bitMatrixBFS levels match BFS depths");
+    }
+    check(m->uniqueLabels, "V.txt has no shared labels");
+    m = freeBitMatrix(m);
+    free(row);
+    free(level);
+    free(expected);
+    g = freeGraph(g);
+
+    // repeats, unknown and shared labels must not change the output of small (dense) graphs
+    writeFixture("rg_dup.txt", "2\nA B B -1\nB A X -1\n");
+    g = loadGraph("rg_dup.txt");
+    check(isDenseGraph(g), "rg_dup.txt is dense");
+    ProduceDegreeFile(g, "rg_dup.txt");
+    check(fileHolds("rg_dup-DEGREE.TXT", "A 2\nB 2\n"), "DEGREE counts repeated and unknown neighbors");
+    ProduceMatrixFile(g, "rg_dup.txt");
+    check(fileHolds("rg_dup-MATRIX.TXT", "   A  B  \nA  0  1  \nB  1  0  \n"), "MATRIX of rg_dup.txt");
+    g = freeGraph(g);
+    remove("rg_dup.txt");
+
+    writeFixture("rg_shared.txt", "3\nA B -1\nB A -1\nB A C -1\n");
+    g = loadGraph("rg_shared.txt");
+    ProduceDegreeFile(g, "rg_shared.txt");
+    check(fileHolds("rg_shared-DEGREE.TXT", "A 1\nB 1\nB 2\n"), "DEGREE with a shared label");
+    ProduceMatrixFile(g, "rg_shared.txt");
+    check(fileHolds("rg_shared-MATRIX.TXT", "   A  B  B  \nA  0  1  1  \nB  1  0  0  \nB  1  0  0  \n"),
+          "MATRIX marks every vertex carrying a neighbor's label");
+    g = freeGraph(g);
+    remove("rg_shared.txt");
+}
+
+/*
+    Purpose: Checks the chunked parallel loader against the serial one.
+    Returns: void
+*/
+void checkParallelLoader(void) {
+    const char* files[4] = { "T.txt", "U.txt", "V.txt", "rg_random.txt" };
+    writeRandomGraph("rg_random.txt", 3000, 9000, 31u);
+    for (int f = 0; f < 4; f++) {
+        Graph* serial = loadGraph(files[f]);
+        for (int threads = 1; threads <= 7; threads += 2) {
+            Graph* parallel = NULL;
+            strFile name;
+            strcpy(name, files[f]);
+            check(ReadInputFileParallel(name, &parallel, threads) == 1, "parallel loader reads the file");
+            check(parallel != NULL && sameGraph(serial, parallel), "parallel loader builds the serial graph");
+            check(parallel != NULL && sameReport(ProduceDegreeFile, serial, parallel, "DEGREE"),
+                  "parallel loader gives the same DEGREE report");
+            if (parallel != NULL) {
+                parallel = freeGraph(parallel);
+            }
+        }
+        serial = freeGraph(serial);
+    }
+    remove("rg_random.txt");
+
+    Graph* g = NULL;
+    strFile name = "rg_missing.txt";
+    check(ReadInputFileParallel(name, &g, 2) == 0 && g == NULL, "parallel loader reports a missing file");
+    writeFixture("rg_short.txt", "4\nA B -1\nB A -1\n");
+    strcpy(name, "rg_short.txt");
+    check(ReadInputFileParallel(name, &g, 2) == -1 && g == NULL, "parallel loader rejects a short file");
+    writeFixture("rg_short.txt", "A B -1\nB A -1\n");
+    check(ReadInputFileParallel(name, &g, 2) == -1 && g == NULL, "parallel loader rejects a missing header");
+    writeFixture("rg_short.txt", "1\nA -1\nB -1\n");
+    check(ReadInputFileParallel(name, &g, 2) == 1 && g != NULL && g->numVertices == 1,
+          "parallel loader ignores records past the declared count");
+    if (g != NULL) {
+        g = freeGraph(g);
+    }
+    remove("rg_short.txt");
+}
+
+/*
+    Purpose: Checks countTriangles against a brute-force count.
+    Returns: void
+*/
+void checkTriangles(void) {
+    // K4 on A-D plus a pendant E: 3 triangles at each of A-D, none at E
+    writeFixture("rg_k4.txt", "5\nA B C D -1\nB A C D -1\nC A B D E -1\nD A B C -1\nE C -1\n");
+    Graph* g = loadGraph("rg_k4.txt");
+    GraphCSR* csr = buildSortedCSR(g);
+    int tri[5];
+    countTriangles(csr, tri);
+    check(tri[0] == 3 && tri[1] == 3 && tri[2] == 3 && tri[3] == 3 && tri[4] == 0, "triangles of K4 plus a pendant");
+    csr = freeCSR(csr);
+    g = freeGraph(g);
+    remove("rg_k4.txt");
+
+    writeRandomGraph("rg_random.txt", 300, 2000, 7u);
+    g = loadGraph("rg_random.txt");
+    csr = buildSortedCSR(g);
+    BitMatrix* m = buildBitMatrix(g);
+    int n = g->numVertices;
+    int* counted = malloc(n * sizeof(int));
+    countTriangles(csr, counted);
+    int agree = 1;
+    for (int v = 0; v < n; v++) {
+        int brute = 0;
+        for (int a = csr->offsets[v]; a < csr->offsets[v + 1]; a++) {
+            for (int b = a + 1; b < csr->offsets[v + 1]; b++) {
+                brute += hasEdge(m, csr->neighbors[a], csr->neighbors[b]);
+            }
+        }
+        agree = agree && brute == counted[v];
+    }
+    check(agree, "countTriangles matches a brute-force count");
+    free(counted);
+    m = freeBitMatrix(m);
+    csr = freeCSR(csr);
+    g = freeGraph(g);
+    remove("rg_random.txt");
+}
+
+/*
+    Purpose: Checks PageRank on graphs with known answers and across reordering.
+    Returns: void
+*/
+void checkPageRank(void) {
+    // a cycle is symmetric: every vertex gets 1/V
+    writeFixture("rg_cycle.txt", "4\nA B D -1\nB A C -1\nC B D -1\nD C A -1\n");
+    Graph* g = loadGraph("rg_cycle.txt");
+    GraphCSR* csr = buildCSR(g);
+    double rank[4];
+    computePageRank(csr, NULL, rank);
+    check(fabs(rank[0] - 0.25) < 1e-9 && fabs(rank[1] - 0.25) < 1e-9 &&
+          fabs(rank[2] - 0.25) < 1e-9 && fabs(rank[3] - 0.25) < 1e-9, "PageRank of a cycle is uniform");
+    csr = freeCSR(csr);
+    g = freeGraph(g);
+    remove("rg_cycle.txt");
+
+    g = loadGraph("V.txt");
+    csr = buildCSR(g);
+    double* scores = malloc(g->numVertices * sizeof(double));
+    computePageRank(csr, NULL, scores);
+    double total = 0.0;
+    for (int v = 0; v < g->numVertices; v++) {
+        total += scores[v];
+    }
+    check(fabs(total - 1.0) < 1e-9, "PageRank scores sum to 1");
+    free(scores);
+    csr = freeCSR(csr);
+
+    // Gardner and Lois tie; a new numbering must not flip them on rounding noise
+    for (int mode = REORDER_DEGREE; mode <= REORDER_RCM; mode++) {
+        Graph* moved = loadGraph("V.txt");
+        ReorderGraph(moved, (ReorderMode) mode);
+        check(sameReport(ProduceRankFile, g, moved, "RANK"), "reordering keeps the RANK report");
+        moved = freeGraph(moved);
+    }
+    g = freeGraph(g);
+}
+
+/*
+    Purpose: Counts hop distances and shortest paths from one source, for brute-force checks.
+    Returns: void
+    @param  : csr   — sorted CSR
+    @param  : s     — source vertex
+    @param  : dist  — output; distance from s, -1 if unreached
+    @param  : sigma — output; number of shortest paths from s
+    @param  : queue — scratch of csr->numVertices ints
+*/
+void countPaths(const GraphCSR* csr, int s, int dist[], double sigma[], int queue[]) {
+    int front = 0, rear = 0;
+    for (int v = 0; v < csr->numVertices; v++) {
+        dist[v] = -1;
+        sigma[v] = 0.0;
+    }
+    dist[s] = 0;
+    sigma[s] = 1.0;
+    queue[rear] = s;
+    rear++;
+    while (front < rear) {
+        int u = queue[front];
+        front++;
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int w = csr->neighbors[e];
+            if (dist[w] < 0) {
+                dist[w] = dist[u] + 1;
+                queue[rear] = w;
+                rear++;
+            }
+            if (dist[w] == dist[u] + 1) {
+                sigma[w] += sigma[u];
+            }
+        }
+    }
+}
+
+/*
+    Purpose: Checks betweenness against known values and a brute-force pair count.
+    Returns: void
+*/
+void checkBetweenness(void) {
+    Graph* g = loadGraph("T.txt");
+    GraphCSR* csr = buildSortedCSR(g);
+    double bc[5];
+    computeBetweenness(csr, 0, 1u, bc);
+    check(bc[0] == 0.0 && bc[1] == 5.0 && bc[2] == 3.0 && bc[3] == 0.0 && bc[4] == 0.0,
+          "betweenness on T.txt");
+    csr = freeCSR(csr);
+    g = freeGraph(g);
+
+    writeRandomGraph("rg_random.txt", 60, 90, 11u);
+    g = loadGraph("rg_random.txt");
+    csr = buildSortedCSR(g);
+    int n = csr->numVertices, s, t, v;
+    double* exact = malloc(n * sizeof(double));
+    double* sampled = malloc(n * sizeof(double));
+    double* brute = calloc(n, sizeof(double));
+    int* dist = malloc((size_t) n * n * sizeof(int));
+    double* sigma = malloc((size_t) n * n * sizeof(double));
+    int* queue = malloc(n * sizeof(int));
+    for (s = 0; s < n; s++) {
+        countPaths(csr, s, dist + (size_t) s * n, sigma + (size_t) s * n, queue);
+    }
+    for (s = 0; s < n; s++) {
+        for (t = s + 1; t < n; t++) {
+            int st = dist[(size_t) s * n + t];
+            for (v = 0; v < n && st > 0; v++) {
+                int sv = dist[(size_t) s * n + v];
+                int vt = dist[(size_t) v * n + t];
+                if (v != s && v != t && sv > 0 && vt > 0 && sv + vt == st) {
+                    brute[v] += sigma[(size_t) s * n + v] * sigma[(size_t) v * n + t] / sigma[(size_t) s * n + t];
+                }
+            }
+        }
+    }
+    computeBetweenness(csr, 0, 1u, exact);
+    computeBetweenness(csr, n, 1u, sampled);   // samples >= V is the exact algorithm
+    int agree = 1;
+    for (v = 0; v < n; v++) {
+        agree = agree && fabs(exact[v] - brute[v]) < 1e-9 && fabs(sampled[v] - exact[v]) < 1e-9;
+    }
+    check(agree, "betweenness matches a brute-force pair count");
+    computeBetweenness(csr, 20, 5u, sampled);
+    double total = 0.0, sampledTotal = 0.0;
+    for (v = 0; v < n; v++) {
+        total += exact[v];
+        sampledTotal += sampled[v];
+    }
+    check(sampledTotal > 0.0 && sampledTotal < 3.0 * total, "sampled betweenness is on the exact scale");
+
+    // ties are decided at the printed precision; hub-sized scores must not overflow
+    VertexScore high = { 0, 2, 1.00004 }, low = { 1, 1, 1.00001 };
+    check(compareBetweennessScore(&high, &low) > 0 && compareRankScore(&high, &low) < 0,
+          "score comparators round to the precision each report prints");
+    VertexScore hub = { 0, 2, 2e15 }, other = { 1, 1, 1e15 };
+    check(compareBetweennessScore(&hub, &other) < 0 && compareBetweennessScore(&other, &hub) > 0 &&
+          compareRankScore(&hub, &other) < 0, "score comparators order very large scores");
+    free(exact);
+    free(sampled);
+    free(brute);
+    free(dist);
+    free(sigma);
+    free(queue);
+    csr = freeCSR(csr);
+    g = freeGraph(g);
+    remove("rg_random.txt");
+}
+
+/*
+    Purpose: Checks eccentricities, diameter and radius against one BFS per vertex.
+    Returns: void
+*/
+void checkEccentricity(void) {
+    int sizes[2] = { 60, 2000 };
+    int edges[2] = { 50, 2600 };
+    for (int r = 0; r < 2; r++) {
+        writeRandomGraph("rg_random.txt", sizes[r], edges[r], 13u + r);
+        Graph* g = loadGraph("rg_random.txt");
+        GraphCSR* csr = buildSortedCSR(g);
+        int n = csr->numVertices, v;
+        int* brute = malloc(n * sizeof(int));
+        int* comp = malloc(n * sizeof(int));
+        int* compSize = calloc(n, sizeof(int));
+        int* ecc = malloc(n * sizeof(int));
+        BFSWorkspace ws;
+        initBFSWorkspace(&ws, n);
+        labelComponents(csr, comp);
+        DiameterResult expected = { 0, 0, 0 };
+        for (v = 0; v < n; v++) {
+            brute[v] = bfsDistances(csr, v, &ws);
+            compSize[comp[v]]++;
+            if (brute[v] > expected.diameter) {
+                expected.diameter = brute[v];
+            }
+        }
+        // the largest component, ties going to the one found first
+        for (v = 0; v < n; v++) {
+            if (compSize[v] > expected.size) {
+                expected.size = compSize[v];
+                expected.radius = n;
+                for (int u = 0; u < n; u++) {
+                    if (comp[u] == v && brute[u] < expected.radius) {
+                        expected.radius = brute[u];
+                    }
+                }
+            }
+        }
+
+        for (int exact = 0; exact <= 1; exact++) {
+            DiameterResult got;
+            computeDiameter(csr, exact, ecc, &got);
+            int agree = got.diameter == expected.diameter && got.radius == expected.radius &&
+                        got.size == expected.size;
+            for (v = 0; v < n; v++) {
+                agree = agree && (ecc[v] == brute[v] || (!exact && ecc[v] == -1));
+            }
+            check(agree, exact ? "exact eccentricities match one BFS per vertex"
+                               : "bounded diameter and radius match one BFS per vertex");
+        }
+        freeBFSWorkspace(&ws);
+        free(brute);
+        free(comp);
+        free(compSize);
+        free(ecc);
+        csr = freeCSR(csr);
+        g = freeGraph(g);
+        remove("rg_random.txt");
+    }
+}
+
+/*
+    Purpose: Checks the compressed blocks and the compressed DEGREE/BFS/DFS reports against the lists.
+    Returns: void
+    Post-condition:
+             - The reports come from ReadCompressedInputFile, which never builds lists.
+             - Every vertex of each graph is used as a start, including one that
+               shares its label with another vertex.
+*/
+void checkCompressed(void) {
+    const char* files[3] = { "V.txt", "rg_random.txt", "rg_shared.txt" };
+    writeRandomGraph("rg_random.txt", 300, 700, 17u);
+    writeFixture("rg_shared.txt", "5\nB A -1\nA B B C X -1\nB A C -1\nC A B C -1\nD -1\n");
+    for (int f = 0; f < 3; f++) {
+        Graph* g = loadGraph(files[f]);
+        GraphCSR* csr = buildSortedCSR(g);
+        CompressedGraph* cg = compressCSR(csr);
+        int n = g->numVertices, v;
+        int* row = malloc((n > 0 ? n : 1) * sizeof(int));
+        int decoded = 1;
+        for (v = 0; v < n; v++) {
+            int count = decodeNeighbors(cg, v, row);
+            decoded = decoded && count == compressedDegree(cg, v) &&
+                      count == csr->offsets[v + 1] - csr->offsets[v] &&
+                      memcmp(row, csr->neighbors + csr->offsets[v], count * sizeof(int)) == 0;
+        }
+        check(decoded, "compressed blocks decode to the sorted CSR rows");
+
+        BFSWorkspace plain, packed;
+        initBFSWorkspace(&plain, n);
+        initBFSWorkspace(&packed, n);
+        int sameDist = 1;
+        for (v = 0; v < n; v++) {
+            sameDist = sameDist && compressedBFS(cg, v, &packed) == bfsDistances(csr, v, &plain) &&
+                       packed.reached == plain.reached;
+            for (int u = 0; u < n; u++) {
+                sameDist = sameDist && packed.dist[u] == plain.dist[u];
+            }
+        }
+        check(sameDist, "compressed BFS distances match the CSR BFS");
+
+        CompressedInput* ci = NULL;
+        strFile name;
+        strcpy(name, files[f]);
+        check(ReadCompressedInputFile(name, &ci) == 1, "the compressed loader reads the file");
+        int* labelOrder = malloc((n > 0 ? n : 1) * sizeof(int));
+        CompressedGraph* byLabel = compressGraphByLabel(g, labelOrder);
+        check(ci->graph->numEdges == byLabel->numEdges && ci->graph->dataSize == byLabel->dataSize &&
+              memcmp(ci->graph->data, byLabel->data, byLabel->dataSize) == 0,
+              "the compressed loader encodes the blocks compressGraphByLabel builds");
+        byLabel = freeCompressedGraph(byLabel);
+        free(labelOrder);
+
+        ProduceDegreeFile(g, "rg_a.txt");
+        ProduceCompressedDegreeFile(ci, "rg_b.txt");
+        check(sameFiles("rg_a-DEGREE.TXT", "rg_b-DEGREE.TXT"), "compressed DEGREE report matches the lists");
+
+        int sameOrder = 1;
+        for (v = 0; v < n; v++) {
+            const char* label = vertexLabel(g, v);
+            ProduceBFSFile(g, "rg_a.txt", label);
+            ProduceCompressedTraversalFile(ci, "rg_b.txt", label, 0);
+            sameOrder = sameFiles("rg_a-BFS.TXT", "rg_b-BFS.TXT") && sameOrder;
+            ProduceDFSFile(g, "rg_a.txt", label);
+            ProduceCompressedTraversalFile(ci, "rg_b.txt", label, 1);
+            sameOrder = sameFiles("rg_a-DFS.TXT", "rg_b-DFS.TXT") && sameOrder;
+        }
+        check(sameOrder, "compressed BFS/DFS reports match the list traversals");
+        ci = freeCompressedInput(ci);
+
+        freeBFSWorkspace(&plain);
+        freeBFSWorkspace(&packed);
+        free(row);
+        cg = freeCompressedGraph(cg);
+        csr = freeCSR(csr);
+        g = freeGraph(g);
+    }
+    remove("rg_random.txt");
+    remove("rg_shared.txt");
+
+    CompressedInput* ci = NULL;
+    strFile missing = "rg_missing.txt", shortFile = "rg_short.txt";
+    writeFixture(shortFile, "3\nA B -1\nB A -1\n");
+    check(ReadCompressedInputFile(missing, &ci) == 0 && ReadCompressedInputFile(shortFile, &ci) < 0 && ci == NULL,
+          "the compressed loader rejects missing and short files");
+    remove(shortFile);
+}
+
+/*
+    Purpose: Checks the on-disk graph reports against the in-memory ones.
+    Returns: void
+    Post-condition:
+             - Covers repeated neighbors, shared labels and neighbor labels that
+               are not vertices, with a one-page cache so pages are evicted.
+*/
+void checkOutOfCore(void) {
+    const char* files[4] = { "V.txt", "rg_random.txt", "rg_shared.txt", "rg_dangling.txt" };
+    writeRandomGraph("rg_random.txt", 3000, 9000, 19u);
+    writeFixture("rg_shared.txt", "5\nB A -1\nA B B C X -1\nB A C -1\nC A B C -1\nD -1\n");
+    writeFixture("rg_dangling.txt", "2\nA B B -1\nB A X -1\n");
+    for (int f = 0; f < 4; f++) {
+        strFile name;
+        strcpy(name, files[f]);
+        check(ConvertInputToGraphFile(name, "rg_b.bin"), "ConvertInputToGraphFile writes the graph file");
+        OOCGraph* disk = openGraphFile("rg_b.bin", 1);
+        check(disk != NULL, "openGraphFile reads back a converted file");
+        if (disk == NULL) {
+            continue;
+        }
+        Graph* g = loadGraph(files[f]);
+        uint64_t entries = 0;
+        for (int v = 0; v < g->numVertices; v++) {
+            for (Node* cur = g->adjList[v].head->edge; cur != NULL; cur = cur->edge) {
+                entries++;
+            }
+        }
+        check(disk->numVertices == g->numVertices && disk->numEdges == entries,
+              "graph file header counts every adjacency entry");
+
+        ProduceDegreeFile(g, "rg_a.txt");
+        ProduceOOCDegreeFile(disk, "rg_b.txt");
+        check(sameFiles("rg_a-DEGREE.TXT", "rg_b-DEGREE.TXT"), "on-disk DEGREE matches ProduceDegreeFile");
+        ProduceListFile(g, "rg_a.txt");
+        ProduceOOCListFile(disk, "rg_b.txt");
+        check(sameFiles("rg_a-LIST.TXT", "rg_b-LIST.TXT"), "on-disk LIST matches ProduceListFile");
+
+        int sameOrder = 1;
+        for (int v = 0; v < g->numVertices; v += 1 + g->numVertices / 50) {
+            const char* start = vertexLabel(g, v);
+            ProduceBFSFile(g, "rg_a.txt", start);
+            ProduceOOCTraversalFile(disk, "rg_b.txt", start, 0);
+            sameOrder = sameFiles("rg_a-BFS.TXT", "rg_b-BFS.TXT") && sameOrder;
+            ProduceDFSFile(g, "rg_a.txt", start);
+            ProduceOOCTraversalFile(disk, "rg_b.txt", start, 1);
+            sameOrder = sameFiles("rg_a-DFS.TXT", "rg_b-DFS.TXT") && sameOrder;
+        }
+        check(sameOrder, "on-disk BFS/DFS reports match the in-memory traversals");
+
+        disk = closeGraphFile(disk);
+        g = freeGraph(g);
+        remove("rg_b.bin");
+    }
+    remove("rg_random.txt");
+    remove("rg_shared.txt");
+    remove("rg_dangling.txt");
+}
+
+#ifndef _WIN32
+/* One thread of the GraphStore stress check. */
+typedef struct _StoreWorker {
+    GraphStore* store;
+    int id;            // reader slot
+    int writer;        // nonzero: publish edited copies; zero: read snapshots
+    int rounds;
+    int base0, base1;  // list lengths of vertices 0 and 1 in the first version
+    int broken;        // snapshots that failed the consistency test
+} StoreWorker;
+
+/*
+    Purpose: Counts the nodes of one adjacency list, head included.
+    Returns: List length
+    @param  : g — graph
+    @param  : v — vertex index
+*/
+int listLength(const Graph* g, int v) {
+    int len = 0;
+    for (Node* cur = g->adjList[v].head; cur != NULL; cur = cur->edge) {
+        len++;
+    }
+    return len;
+}
+
+/*
+    Purpose: Body of a GraphStore stress thread.
+    Returns: NULL
+    @param  : arg — pointer to a StoreWorker
+    Post-condition:
+             - Writers append one node to the lists of vertices 0 and 1 of a copy,
+               so every published version has grown both lists equally; readers
+               count versions where that does not hold or BFS misses a vertex.
+*/
+void* storeWorkerMain(void* arg) {
+    StoreWorker* w = arg;
+    for (int r = 0; r < w->rounds; r++) {
+        const Graph* g = snapshotAcquire(w->store, w->id);
+        if (w->writer) {
+            Graph* next = cloneGraph(g);
+            snapshotRelease(w->store, w->id);
+            appendNode(&next->adjList[0], next->adjList[1].head->label);
+            appendNode(&next->adjList[1], next->adjList[0].head->label);
+            publishGraph(w->store, next);
+        } else {
+            if (listLength(g, 0) - w->base0 != listLength(g, 1) - w->base1 ||
+                BFSVisit(g, 0, NULL, NULL) != g->numVertices) {
+                w->broken++;
+            }
+            snapshotRelease(w->store, w->id);
+        }
+    }
+    return NULL;
+}
+
+/*
+    Purpose: Stresses GraphStore with concurrent writers and readers.
+    Returns: void
+    Post-condition:
+             - Build with -fsanitize=thread (without -fopenmp) to have
+               ThreadSanitizer watch the same run.
+*/
+void checkGraphStore(void) {
+    Graph* g = loadGraph("T.txt");
+    StoreWorker workers[6];
+    pthread_t threads[6];
+    int base0 = listLength(g, 0), base1 = listLength(g, 1), t, broken = 0;
+    GraphStore* store = createGraphStore(g, 6);
+    for (t = 0; t < 6; t++) {
+        StoreWorker w = { store, t, t < 2, t < 2 ? 300 : 3000, base0, base1, 0 };
+        workers[t] = w;
+        pthread_create(&threads[t], NULL, storeWorkerMain, &workers[t]);
+    }
+    for (t = 0; t < 6; t++) {
+        pthread_join(threads[t], NULL);
+        broken += workers[t].broken;
+    }
+    check(broken == 0, "GraphStore readers always see a whole published version");
+
+    reclaimSnapshots(store);
+    check(store->numRetired == 0, "reclaimSnapshots frees the last retired version once readers are gone");
+    const Graph* last = snapshotAcquire(store, 0);
+    check(listLength(last, 0) > base0, "GraphStore keeps the latest published version");
+    snapshotRelease(store, 0);
+    store = freeGraphStore(store);
+}
+#endif
+
+/* Visit order and depths, filled by orderVisitor. */
+typedef struct _VisitLog {
+    int* order;
+    int* depth;        // indexed by vertex
+    int count;
+} VisitLog;
+
+/* Visitor appending each vertex to a VisitLog (ctx). */
+int orderVisitor(const Graph* g, int vIndex, int depth, void* ctx) {
+    VisitLog* log = ctx;
+    (void) g;
+    log->order[log->count] = vIndex;
+    log->depth[vIndex] = depth;
+    log->count++;
+    return 0;
+}
+
+#ifndef _WIN32
+/*
+    Purpose: Checks sharded BFS and components against BFSVisit and labelComponents.
+    Returns: void
+    Post-condition:
+             - Runs first in main: startShardWorkers must fork before the first
+               OpenMP parallel region.
+*/
+void checkSharded(void) {
+    const char* files[2] = { "V.txt", "rg_random.txt" };
+    writeRandomGraph("rg_random.txt", 400, 500, 23u);
+    for (int f = 0; f < 2; f++) {
+        Graph* g = loadGraph(files[f]);
+        GraphCSR* csr = buildCSR(g);
+        int n = g->numVertices, v;
+        int* comp = malloc(n * sizeof(int));
+        int* shardComp = malloc(n * sizeof(int));
+        int* order = malloc(n * sizeof(int));
+        int* dist = malloc(n * sizeof(int));
+        VisitLog log = { malloc(n * sizeof(int)), malloc(n * sizeof(int)), 0 };
+        int components = labelComponents(csr, comp);
+
+        for (int shards = 1; shards <= 4; shards++) {
+            for (int mode = 0; mode < 2; mode++) {
+                ShardedGraph* sg = partitionGraph(g, shards, mode ? PARTITION_RANGE : PARTITION_HASH);
+                int sameRows = 1;
+                for (v = 0; v < n; v++) {
+                    const GraphShard* sh = &sg->shards[shardOwner(sg, v)];
+                    int i = shardLocalIndex(sg, v);
+                    int cnt = getSortedNeighbors(g, v, order);
+                    sameRows = sameRows && sh->globalId[i] == v && cnt == sh->offsets[i + 1] - sh->offsets[i] &&
+                               memcmp(order, sh->neighbors + sh->offsets[i], cnt * sizeof(int)) == 0;
+                }
+                check(sameRows, "shard rows hold the label-sorted neighbors");
+                ShardWorker workers[4];
+                if (!startShardWorkers(sg, workers)) {
+                    check(0, "startShardWorkers forks one worker per shard");
+                    sg = freeShardedGraph(sg);
+                    continue;
+                }
+                int sameBFS = 1;
+                for (int s = 0; s < n; s += 1 + n / 20) {
+                    log.count = 0;
+                    for (v = 0; v < n; v++) {
+                        log.depth[v] = -1;
+                    }
+                    BFSVisit(g, s, orderVisitor, &log);
+                    int reached = shardedBFS(sg, workers, s, order, dist);
+                    sameBFS = sameBFS && reached == log.count &&
+                              memcmp(order, log.order, reached * sizeof(int)) == 0 &&
+                              memcmp(dist, log.depth, n * sizeof(int)) == 0;
+                }
+                check(sameBFS, "sharded BFS matches BFSVisit order and depths");
+                check(shardedComponents(sg, workers, shardComp) == components &&
+                      memcmp(shardComp, comp, n * sizeof(int)) == 0,
+                      "sharded components match labelComponents");
+                stopShardWorkers(shards, workers);
+                sg = freeShardedGraph(sg);
+            }
+        }
+        free(comp);
+        free(shardComp);
+        free(order);
+        free(dist);
+        free(log.order);
+        free(log.depth);
+        csr = freeCSR(csr);
+        g = freeGraph(g);
+    }
+    remove("rg_random.txt");
+}
+#endif
+
+/*
+    Purpose: Checks the edge-list loader's comment handling and per-line pairing.
+    Returns: void
+*/
+void checkEdgeList(void) {
+    strFile name;
+    Graph* g = NULL;
+    strcpy(name, "rg_edges.txt");
+
+    // a lone '#' must not swallow the line after it
+    writeFixture("rg_edges.txt", "#header\nA B\n#\nB C\nC D\nD E\n");
+    writeFixture("rg_adj.txt", "5\nA B -1\nB A C -1\nC B D -1\nD C E -1\nE D -1\n");
+    check(ReadEdgeListFile(name, &g, 1) == 1, "ReadEdgeListFile loads an edge list");
+    Graph* expected = loadGraph("rg_adj.txt");
+    check(sameGraph(g, expected), "comment lines drop no edges");
+    g = freeGraph(g);
+    expected = freeGraph(expected);
+
+    // an odd label count only loses that line's last label
+    writeFixture("rg_edges.txt", "A B C\r\nD E\n# c\nF\nG H # trailing comment\nK # x\nL M\nI J");
+    writeFixture("rg_adj.txt", "10\nA B -1\nB -1\nD E -1\nE -1\nG H -1\nH -1\nL M -1\nM -1\nI J -1\nJ -1\n");
+    check(ReadEdgeListFile(name, &g, 0) == 1, "ReadEdgeListFile loads an edge list with odd lines");
+    check(getVertexIndex(g, "C") < 0 && getVertexIndex(g, "F") < 0 && getVertexIndex(g, "K") < 0,
+          "unpaired labels are not vertices");
+    expected = loadGraph("rg_adj.txt");
+    check(sameGraph(g, expected), "odd label counts do not shift later lines");
+    g = freeGraph(g);
+    expected = freeGraph(expected);
+    remove("rg_edges.txt");
+    remove("rg_adj.txt");
+}
+
+/*
+    Purpose: Checks the EGO report against known subgraphs and a depth-bounded BFS.
+    Returns: void
+*/
+void checkEgo(void) {
+    Graph* g = loadGraph("T.txt");
+    ProduceEgoFile(g, "rg_t.txt", "A", 0);
+    check(fileHolds("rg_t-EGO.TXT", "1\nA -1\n"), "EGO with 0 hops is the center alone");
+    ProduceEgoFile(g, "rg_t.txt", "A", 1);
+    check(fileHolds("rg_t-EGO.TXT", "2\nA B -1\nB A -1\n"), "EGO with 1 hop on T.txt");
+    ProduceEgoFile(g, "rg_t.txt", "A", 2);
+    check(fileHolds("rg_t-EGO.TXT", "4\nA B -1\nB A C E -1\nC B -1\nE B -1\n"), "EGO with 2 hops on T.txt");
+    ProduceEgoFile(g, "rg_t.txt", "Nobody", 1);
+    FILE* none = fopen("rg_t-EGO.TXT", "r");
+    check(none == NULL, "EGO writes nothing for a missing vertex");
+    if (none != NULL) {
+        fclose(none);
+    }
+    g = freeGraph(g);
+
+    // a long input name must fit the output name like the other reports
+    writeRandomGraph("rg_egoinput-long.txt", 500, 900, 29u);
+    g = loadGraph("rg_egoinput-long.txt");
+    int sameSize = 1;
+    for (int hops = 0; hops <= 4; hops++) {
+        TraversalLimits lim = { hops, -1, -1 };
+        int reached = 0;
+        BFSBounded(g, 7, &lim, NULL, NULL, &reached);
+        ProduceEgoFile(g, "rg_egoinput-long.txt", vertexLabel(g, 7), hops);
+        rename("rg_egoinput-long-EGO.TXT", "rg_ego.txt");   // too long for a strFile
+        Graph* ego = loadGraph("rg_ego.txt");
+        Graph* direct = extractEgoNetwork(g, 7, hops);
+        sameSize = sameSize && ego->numVertices == reached && sameGraph(ego, direct);
+        ego = freeGraph(ego);
+        direct = freeGraph(direct);
+        remove("rg_ego.txt");
+    }
+    check(sameSize, "EGO holds exactly the vertices within k hops");
+    g = freeGraph(g);
+    remove("rg_egoinput-long.txt");
+}
+
+int main() {
+#ifndef _WIN32
+    checkSharded();   // forks, so before any OpenMP region
+#endif
+    checkVisitorTraversals();
+    checkBoundedTraversals();
+    checkReorder();
+    checkLabelKeys();
+    checkLabelArena();
+    checkBitMatrix();
+    checkParallelLoader();
+    checkTriangles();
+    checkPageRank();
+    checkBetweenness();
+    checkEccentricity();
+    checkCompressed();
+    checkOutOfCore();
+#ifndef _WIN32
+    checkGraphStore();
+#endif
+    checkEdgeList();
+    checkEgo();
+
+    printf("%d check(s) failed\n", failures);
+    return failures;
+}
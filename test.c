@@ -18,11 +18,11 @@ void printGraph(const Graph* g) {
             continue;
         }
         // print the source vertex
-        printf("%s", cur->vertexName);
+        printf("%s", labelText(g->labels, cur->label));
         // print all neighbors
         cur = cur->edge;
         while (cur) {
-            printf(" -> %s", cur->vertexName);
+            printf(" -> %s", labelText(g->labels, cur->label));
             cur = cur->edge;
         }
         printf(" -> NULL\n");
@@ -44,10 +44,10 @@ int main() {
 
     strName vertex;
     printf("Input start vertex for traversal: ");
-    scanf("%s", vertex);
+    scanf("%255s", vertex);
 
-    strName dfs[g->numVertices];
-    strName bfs[g->numVertices];
+    const char* dfs[g->numVertices];
+    const char* bfs[g->numVertices];
 
     
     int dfsIndex = DFS(g, vertex, dfs);